@@ -3,63 +3,25 @@
 # Project created by QtCreator 2017-08-15T17:21:42
 #
 #-------------------------------------------------
-QMAKE_CXXFLAGS += -std=c++17
-QT       += core gui
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
-TARGET = Parchis
-TEMPLATE = app
-
-# The following define makes your compiler emit warnings if you use
-# any feature of Qt which as been marked as deprecated (the exact warnings
-# depend on your compiler). Please consult the documentation of the
-# deprecated API in order to know how to port your code away from it.
-DEFINES += QT_DEPRECATED_WARNINGS
-
-# You can also make your code fail to compile if you use deprecated APIs.
-# In order to do so, uncomment the following line.
-# You can also select to disable deprecated APIs only up to a certain version of Qt.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-
-SOURCES += \
-        main.cpp \
-        mainwindow.cpp \
-    game.cpp \
-    gamewidget.cpp \
-    board.cpp \
-    playersettings.cpp \
-    gamestate.cpp \
-    gamewindow.cpp \
-    dicegenerators.cpp \
-    actions.cpp \
-    aiengine.cpp \
-    gamemanager.cpp
-
-HEADERS += \
-        mainwindow.h \
-    game.h \
-    utilities.h \
-    visitor.h \
-    gamewidget.h \
-    board.h \
-    playersettings.h \
-    gamestate.h \
-    constants.h \
-    gamewindow.h \
-    dicegenerators.h \
-    dice.h \
-    gamewidget_p.h \
-    actions.h \
-    action.h \
-    aiengine.h \
-    gamemanager.h \
-    commandresult.h \
-    gamemanager_p.h
-
-FORMS += \
-        mainwindow.ui \
-    gamewindow.ui
+# core is the rules engine and the AI without any Qt dependency, gui is the Parchis application
+# built on top of it and tools are headless programs for compute work
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    core \
+    gui \
+    selfplay \
+    perft \
+    bench
+
+gui.depends = core
+selfplay.subdir = tools/selfplay
+selfplay.depends = core
+perft.subdir = tools/perft
+perft.depends = core
+bench.subdir = tools/bench
+bench.depends = core
 
 DISTFILES += \
     to_do.txt \
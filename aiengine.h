@@ -1,12 +0,0 @@
-#ifndef AIENGINE_H
-#define AIENGINE_H
-
-#include "game.h"
-
-class AiEngine
-{
-public:
-    AiEngine();
-};
-
-#endif // AIENGINE_H
@@ -0,0 +1,112 @@
+#ifndef ACTION_H
+#define ACTION_H
+
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "actionarena.h"
+#include "visitor.h"
+
+#define CLONABLE() \
+    protected: \
+    auto cloneImpl() const -> decltype(clone()) override \
+    { return Action::create<std::decay_t<decltype(*this)>>(*this); } \
+    auto cloneImpl(ActionArena & arena) const -> decltype(clone()) override \
+    { return Action::createCopy(arena, *this); } \
+    private:
+
+#define ACTION_KIND(kindValue) \
+    public: \
+    static constexpr ActionKind staticKind = ActionKind::kindValue; \
+    ActionKind kind() const override { return staticKind; } \
+    private:
+
+namespace parchis
+{
+
+//Tags of the action types defined in actions.h, used by parchis::visit to dispatch without RTTI.
+//Other action types are Extension and can only be visited through the acyclic visitor.
+enum class ActionKind
+{
+    Extension,
+    Complex,
+    PawnTired,
+    PawnRelocation,
+    DiceUsed,
+    Dice,
+    ActionAndTurn,
+    PlayerFinished,
+    GameFinished
+};
+
+struct GameState;
+class Action;
+
+//Deletes heap actions; actions living in an ActionArena are only destroyed, the arena frees
+//their memory
+struct ActionDeleter
+{
+    void operator()(const Action * action) const;
+
+    bool inArena = false;
+};
+
+using ActionUptr = std::unique_ptr<Action, ActionDeleter>;
+using ConstActionUptr = std::unique_ptr<const Action, ActionDeleter>;
+using ActionSptr = std::shared_ptr<Action>;
+using ConstActionSptr = std::shared_ptr<const Action>;
+
+class Action : public Loki::BaseVisitable<void, Loki::DefaultCatchAll, true>
+{
+public:
+    LOKI_DEFINE_CONST_VISITABLE()
+
+    virtual ~Action() = default;
+    virtual ActionKind kind() const { return ActionKind::Extension; }
+    virtual ActionUptr commit(GameState & gameState) const = 0;
+
+    ActionUptr clone() const { return cloneImpl(); }
+    ActionUptr clone(ActionArena & arena) const { return cloneImpl(arena); }
+
+    template <class ActionT, class ... Args>
+    static ActionUptr create(Args && ... args)
+    {
+        return ActionUptr{new ActionT{std::forward<Args>(args) ...}};
+    }
+
+    template <class ActionT, class ... Args>
+    static ActionUptr create(ActionArena & arena, Args && ... args)
+    {
+        void * memory = arena.allocate(sizeof(ActionT), alignof(ActionT));
+
+        return ActionUptr{new(memory) ActionT{std::forward<Args>(args) ...}, ActionDeleter{true}};
+    }
+
+    //Copies the action into the arena. Actions owning containers take a (const ActionT &,
+    //ActionArena *) constructor to copy them into the arena too
+    template <class ActionT>
+    static ActionUptr createCopy(ActionArena & arena, const ActionT & action)
+    {
+        if constexpr(std::is_constructible_v<ActionT, const ActionT &, ActionArena *>)
+            return create<ActionT>(arena, action, &arena);
+        else
+            return create<ActionT>(arena, action);
+    }
+
+protected:
+    virtual ActionUptr cloneImpl() const = 0;
+    virtual ActionUptr cloneImpl(ActionArena & arena) const = 0;
+};
+
+inline void ActionDeleter::operator()(const Action * action) const
+{
+    if(inArena)
+        action->~Action();
+    else
+        delete action;
+}
+
+}
+
+#endif // ACTION_H
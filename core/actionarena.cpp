@@ -0,0 +1,25 @@
+#include "actionarena.h"
+
+namespace parchis
+{
+
+void ActionArena::release()
+{
+    _buffer.release();
+    _counted.resetAllocationCount();
+    _heap.resetAllocationCount();
+}
+
+void * ActionArena::CountingResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    ++_allocationCount;
+    return _upstream->allocate(bytes, alignment);
+}
+
+void ActionArena::CountingResource::do_deallocate(void * p, std::size_t bytes,
+                                                  std::size_t alignment)
+{
+    _upstream->deallocate(p, bytes, alignment);
+}
+
+}
@@ -0,0 +1,62 @@
+#ifndef ACTIONARENA_H
+#define ACTIONARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace parchis
+{
+
+//Monotonic arena for the Action trees built during a search. Actions created in an arena and the
+//containers inside them are freed in one shot by release() or the destructor, so they must not
+//outlive it; a heap clone copies everything out and may. Both the allocations served by the arena
+//and the blocks it takes from the heap are counted.
+class ActionArena
+{
+public:
+    //The initial buffer is kept by release(), so a search that fits in it never touches the heap
+    explicit ActionArena(std::size_t initialSize = 16 * 1024)
+        : _initialBuffer{new std::byte[initialSize]}, _heap{std::pmr::new_delete_resource()},
+          _buffer{_initialBuffer.get(), initialSize, &_heap}, _counted{&_buffer} {}
+
+    ActionArena(const ActionArena &) = delete;
+    ActionArena & operator=(const ActionArena &) = delete;
+
+    std::pmr::memory_resource * resource() { return &_counted; }
+    void * allocate(std::size_t size, std::size_t alignment)
+        { return _counted.allocate(size, alignment); }
+    void release();
+
+    std::size_t allocationCount() const { return _counted.allocationCount(); }
+    std::size_t heapAllocationCount() const { return _heap.allocationCount(); }
+
+private:
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        explicit CountingResource(std::pmr::memory_resource * upstream)
+            : _upstream{upstream} {}
+
+        std::size_t allocationCount() const { return _allocationCount; }
+        void resetAllocationCount() { _allocationCount = 0; }
+
+    private:
+        void * do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+            { return this == &other; }
+
+        std::pmr::memory_resource * _upstream;
+        std::size_t _allocationCount = 0;
+    };
+
+    std::unique_ptr<std::byte[]> _initialBuffer;
+    CountingResource _heap;
+    std::pmr::monotonic_buffer_resource _buffer;
+    CountingResource _counted;
+};
+
+}
+
+#endif // ACTIONARENA_H
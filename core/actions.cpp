@@ -5,6 +5,15 @@
 namespace parchis
 {
 
+ActionComplex::ActionComplex(const ActionComplex & other, ActionArena * arena)
+{
+    Container subActions{_private::copyResource(arena)};
+
+    for(const auto & subAction : other.subActions())
+        subActions.emplace_back(arena ? subAction->clone(*arena) : subAction->clone());
+    _subActions = makeSharedContainer(std::move(subActions));
+}
+
 ActionUptr ActionComplex::commit(GameState & gameState) const
 {
     Container inverseSubActions;
@@ -20,7 +29,7 @@ ActionPawnTired::ActionPawnTired(PawnId pawnId, bool tired)
     Container params;
 
     params.emplace_back(pawnId, tired);
-    _params = std::make_shared<Container>(std::move(params));
+    _params = makeSharedContainer(std::move(params));
 }
 
 ActionUptr ActionPawnTired::commit(GameState & gameState) const
@@ -41,7 +50,7 @@ ActionPawnRelocation::ActionPawnRelocation(const PawnRelocation & pawnRelocation
     Container pawnRelocations;
 
     pawnRelocations.emplace_back(pawnRelocation);
-    _pawnRelocations = std::make_shared<Container>(std::move(pawnRelocations));
+    _pawnRelocations = makeSharedContainer(std::move(pawnRelocations));
 }
 
 ActionUptr ActionPawnRelocation::commit(GameState & gameState) const
@@ -61,7 +70,7 @@ ActionUptr ActionDiceUsed::commit(GameState & gameState) const
 {
     ActionUptr inverseAction = Action::create<ActionDiceUsed>(gameState.diceUsed);
 
-    gameState.diceUsed = diceUsed();
+    gameState.setDiceUsed(diceUsed());
     return inverseAction;
 }
 
@@ -69,7 +78,7 @@ ActionUptr ActionDice::commit(GameState & gameState) const
 {
     ActionUptr inverseAction = Action::create<ActionDice>(gameState.dice);
 
-    gameState.dice = dice();
+    gameState.setDice(dice());
     return inverseAction;
 }
 
@@ -78,17 +87,16 @@ ActionUptr ActionActionAndTurn::commit(GameState & gameState) const
     ActionUptr inverseAction = Action::create<ActionActionAndTurn>(gameState.playerActing,
                                                                    gameState.playerWithTurn);
 
-    gameState.playerActing = playerTakingAction();
-    gameState.playerWithTurn = playerHavingTurn();
+    gameState.setActionAndTurn(playerTakingAction(), playerHavingTurn());
     return inverseAction;
 }
 
 ActionUptr ActionPlayerFinished::commit(GameState & gameState) const
 {
-    bool isPlayerFinished = gameState.playerSettings.playersFinishedMap().at(player());
+    bool isPlayerFinished = gameState.playerSettings.isPlayerFinished(player());
     ActionUptr inverseAction = Action::create<ActionPlayerFinished>(player(), isPlayerFinished);
 
-    gameState.playerSettings.setPlayerFinished(player(), finished());
+    gameState.setPlayerFinished(player(), finished());
     return inverseAction;
 }
 
@@ -96,7 +104,7 @@ ActionUptr ActionGameFinished::commit(GameState & gameState) const
 {
     ActionUptr inverseAction = Action::create<ActionGameFinished>(gameState.isFinished);
 
-    gameState.isFinished = value();
+    gameState.setFinished(value());
     return inverseAction;
 }
 
@@ -0,0 +1,277 @@
+#ifndef ACTIONS_H
+#define ACTIONS_H
+
+#include "action.h"
+#include "board.h"
+#include "constants.h"
+#include "dice.h"
+#include "visitor.h"
+#include <list>
+#include <memory_resource>
+#include <type_traits>
+
+namespace parchis
+{
+
+//The containers of the actions are allocated from the memory resource of the container passed to
+//the constructor, so building them with an ActionArena resource puts the whole action in the
+//arena. Copies and clones copy the containers into the heap, or into the arena they are cloned
+//into, so a heap clone of an arena action outlives the arena.
+template<class Container>
+std::shared_ptr<const Container> makeSharedContainer(Container && container)
+{
+    std::pmr::polymorphic_allocator<Container> allocator{container.get_allocator().resource()};
+
+    return std::allocate_shared<Container>(allocator, std::move(container));
+}
+
+namespace _private
+{
+
+//Resource the containers of a copy go to: the arena of the copy, or the heap
+inline std::pmr::memory_resource * copyResource(ActionArena * arena)
+{
+    return arena ? arena->resource() : std::pmr::get_default_resource();
+}
+
+}
+
+class ActionComplex : public Action
+{
+public:
+    LOKI_DEFINE_CONST_VISITABLE()
+    CLONABLE()
+    ACTION_KIND(Complex)
+
+public:
+    using Container = std::pmr::list<ConstActionUptr>;
+
+    ActionComplex(Container && subActions)
+        : _subActions{makeSharedContainer(std::move(subActions))} {}
+    ActionComplex(const ActionComplex & other) : ActionComplex(other, nullptr) {}
+    ActionComplex(const ActionComplex & other, ActionArena * arena);
+
+    ActionUptr commit(GameState & gameState) const override;
+    const Container & subActions() const { return *_subActions; }
+
+private:
+    std::shared_ptr<const Container> _subActions;
+};
+
+class ActionPawnTired : public Action
+{
+public:
+    LOKI_DEFINE_CONST_VISITABLE()
+    CLONABLE()
+    ACTION_KIND(PawnTired)
+
+public:
+    using Container = std::pmr::list<std::pair<PawnId, bool>>;
+
+    ActionPawnTired(const Container & params)
+        : _params{makeSharedContainer(Container{params})} {}
+    ActionPawnTired(Container && params)
+        : _params{makeSharedContainer(std::move(params))} {}
+    ActionPawnTired(PawnId pawnId, bool tired);
+    ActionPawnTired(const ActionPawnTired & other) : ActionPawnTired(other, nullptr) {}
+    ActionPawnTired(const ActionPawnTired & other, ActionArena * arena)
+        : _params{makeSharedContainer(Container{other.params(),
+                                                _private::copyResource(arena)})} {}
+
+    ActionUptr commit(GameState & gameState) const override;
+    const Container & params() const { return *_params; }
+
+private:
+    std::shared_ptr<const Container> _params;
+};
+
+struct PawnRelocation
+{
+    PawnRelocation(PawnId _pawnId, LocationId _toLocationId)
+        : pawnId{_pawnId}, toLocationId{_toLocationId} {}
+
+    PawnId pawnId;
+    LocationId toLocationId;
+};
+
+class ActionPawnRelocation : public Action
+{
+public:
+    LOKI_DEFINE_CONST_VISITABLE()
+    CLONABLE()
+    ACTION_KIND(PawnRelocation)
+
+public:
+    using Container = std::pmr::list<PawnRelocation>;
+
+    ActionPawnRelocation(const Container & pawnRelocations)
+        : _pawnRelocations{makeSharedContainer(Container{pawnRelocations})} {}
+    ActionPawnRelocation(Container && pawnRelocations)
+        : _pawnRelocations{makeSharedContainer(std::move(pawnRelocations))} {}
+    ActionPawnRelocation(const PawnRelocation & pawnRelocation);
+    ActionPawnRelocation(PawnId pawnId, LocationId locationId)
+        : ActionPawnRelocation(PawnRelocation{pawnId, locationId}) {}
+    ActionPawnRelocation(const ActionPawnRelocation & other)
+        : ActionPawnRelocation(other, nullptr) {}
+    ActionPawnRelocation(const ActionPawnRelocation & other, ActionArena * arena)
+        : _pawnRelocations{makeSharedContainer(Container{other.pawnRelocations(),
+                                                         _private::copyResource(arena)})} {}
+
+    ActionUptr commit(GameState & gameState) const override;
+    const Container & pawnRelocations() const { return *_pawnRelocations; }
+
+private:
+    std::shared_ptr<const Container> _pawnRelocations;
+};
+
+class ActionDiceUsed : public Action
+{
+public:
+    LOKI_DEFINE_CONST_VISITABLE()
+    CLONABLE()
+    ACTION_KIND(DiceUsed)
+
+public:
+    ActionDiceUsed(int diceUsed) : _diceUsed{diceUsed} {}
+
+    ActionUptr commit(GameState & gameState) const override;
+    int diceUsed() const { return _diceUsed; }
+
+private:
+    int _diceUsed;
+};
+
+class ActionDice : public Action
+{
+public:
+    LOKI_DEFINE_CONST_VISITABLE()
+    CLONABLE()
+    ACTION_KIND(Dice)
+
+public:
+    ActionDice(const Dice<dieCount> & dice) : _dice{dice} {}
+    ActionDice(Dice<dieCount> && dice) : _dice{std::move(dice)} {}
+
+    ActionUptr commit(GameState & gameState) const override;
+    const Dice<dieCount> & dice() const { return _dice; }
+
+private:
+    Dice<dieCount> _dice;
+};
+
+class ActionActionAndTurn : public Action
+{
+public:
+    LOKI_DEFINE_CONST_VISITABLE()
+    CLONABLE()
+    ACTION_KIND(ActionAndTurn)
+
+public:
+    ActionActionAndTurn(int playerTakingAction, int playerHavingTurn)
+        : _playerTakingAction{playerTakingAction},
+          _playerHavingTurn{playerHavingTurn} {}
+
+    ActionUptr commit(GameState & gameState) const override;
+    int playerTakingAction() const { return _playerTakingAction; }
+    int playerHavingTurn() const { return _playerHavingTurn; }
+
+private:
+    int _playerTakingAction;
+    int _playerHavingTurn;
+};
+
+class ActionPlayerFinished : public Action
+{
+public:
+    LOKI_DEFINE_CONST_VISITABLE()
+    CLONABLE()
+    ACTION_KIND(PlayerFinished)
+
+public:
+    ActionPlayerFinished(int player, bool finished)
+        : _player{player}, _finished{finished} {}
+
+    ActionUptr commit(GameState & gameState) const override;
+    int player() const { return _player; }
+    bool finished() const { return _finished; }
+
+private:
+    int _player;
+    bool _finished;
+};
+
+class ActionGameFinished : public Action
+{
+public:
+    LOKI_DEFINE_CONST_VISITABLE()
+    CLONABLE()
+    ACTION_KIND(GameFinished)
+
+public:
+    ActionGameFinished(bool value)
+        : _value(value) {}
+
+    ActionUptr commit(GameState & gameState) const override;
+    int value() const { return _value; }
+
+private:
+    bool _value;
+};
+
+class ActionFullVisitor : public Loki::BaseVisitor,
+                          public Loki::Visitor<Action, void, true>,
+                          public Loki::Visitor<ActionComplex, void, true>,
+                          public Loki::Visitor<ActionPawnTired, void, true>,
+                          public Loki::Visitor<ActionPawnRelocation, void, true>,
+                          public Loki::Visitor<ActionPlayerFinished, void, true>,
+                          public Loki::Visitor<ActionDiceUsed, void, true>,
+                          public Loki::Visitor<ActionDice, void, true>,
+                          public Loki::Visitor<ActionActionAndTurn, void, true>
+{ };
+
+namespace _private
+{
+
+template<class ActionT, class Visitor>
+void visitAs(const Action & action, Visitor & visitor)
+{
+    if constexpr(std::is_invocable_v<Visitor &, const ActionT &>)
+        visitor(static_cast<const ActionT &>(action));
+    else if constexpr(std::is_invocable_v<Visitor &, const Action &>)
+        visitor(action);
+}
+
+}
+
+//Static dispatch over the action types above: one switch on the kind and a static_cast, no RTTI.
+//visitor is called with the concrete action, or with const Action & if it only accepts that;
+//actions it accepts neither way are skipped. Extension actions get the const Action & call.
+template<class Visitor>
+void visit(const Action & action, Visitor && visitor)
+{
+    switch(action.kind())
+    {
+    case ActionKind::Complex:
+        return _private::visitAs<ActionComplex>(action, visitor);
+    case ActionKind::PawnTired:
+        return _private::visitAs<ActionPawnTired>(action, visitor);
+    case ActionKind::PawnRelocation:
+        return _private::visitAs<ActionPawnRelocation>(action, visitor);
+    case ActionKind::DiceUsed:
+        return _private::visitAs<ActionDiceUsed>(action, visitor);
+    case ActionKind::Dice:
+        return _private::visitAs<ActionDice>(action, visitor);
+    case ActionKind::ActionAndTurn:
+        return _private::visitAs<ActionActionAndTurn>(action, visitor);
+    case ActionKind::PlayerFinished:
+        return _private::visitAs<ActionPlayerFinished>(action, visitor);
+    case ActionKind::GameFinished:
+        return _private::visitAs<ActionGameFinished>(action, visitor);
+    case ActionKind::Extension:
+        return _private::visitAs<Action>(action, visitor);
+    }
+}
+
+}
+
+#endif // ACTIONS_H
@@ -0,0 +1,967 @@
+#include "aiengine.h"
+#include "aiengine_p.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <optional>
+
+using namespace parchis;
+
+//The chance estimates below consider single dice and pairs of dice only
+static_assert(dieCount <= 2, "AiEngine supports at most two dice");
+
+enum class TransitionKind
+{
+    None,
+    ForwardJump,
+    BackwardJump,
+    PenEntry
+};
+
+using CommandSequence = std::list<std::pair<Command, ConstActionUptr>>;
+
+Score playerScore(PositionValue posValue, int player)
+{
+    Score ret = posValue.diffs[player] - (posValue.sum - posValue.diffs[player]) /
+            (posValue.playerCount - 1);
+    return ret;
+}
+
+AiEngine::AiEngine()
+{
+
+}
+
+void assertRelSquareIsLegal([[maybe_unused]] int relSquare)
+{
+    assert(relSquare >= 0 && relSquare < squaresInMain + pawnsPerPlayer);
+}
+
+namespace formula
+{
+
+constexpr int nextForwardJump(int relSquare)
+{
+    int ret = ((relSquare + squaresInSide - jumpDistanceFromOrigin) / squaresInSide) *
+            squaresInSide + jumpDistanceFromOrigin;
+
+    return ret < squaresInMain ? ret : -1;
+}
+
+constexpr int nextBackwardJump(int relSquare)
+{
+    int ret = (relSquare + jumpDistanceFromOrigin) / squaresInSide *
+            squaresInSide + squaresInSide - jumpDistanceFromOrigin;
+
+    return ret < squaresInMain ? ret : -1;
+}
+
+constexpr int nextPenEntry(int relSquare)
+{
+    int ret = ((relSquare + squaresInSide - penEntryDistanceFromOrigin) / squaresInSide) *
+            squaresInSide + penEntryDistanceFromOrigin;
+
+    return ret < squaresInMain ? ret : -1;
+}
+
+constexpr int previousForwardJump(int relSquare)
+{
+    if(relSquare >= squaresInMain)
+        relSquare = squaresInMain;
+
+    int ret = ((relSquare + squaresInSide - jumpDistanceFromOrigin - 1) / squaresInSide - 1) *
+            squaresInSide + jumpDistanceFromOrigin;
+
+    return ret >= 0 ? ret : -1;
+}
+
+constexpr int previousBackwardJump(int relSquare)
+{
+    if(relSquare >= squaresInMain)
+        relSquare = squaresInMain;
+
+    int ret = ((relSquare + jumpDistanceFromOrigin - 1) / squaresInSide - 1) *
+            squaresInSide + squaresInSide - jumpDistanceFromOrigin;
+
+    return ret >= 0 ? ret : -1;
+}
+
+constexpr int previousPenEntry(int relSquare)
+{
+    if(relSquare >= squaresInMain)
+        relSquare = squaresInMain;
+
+    int ret = ((relSquare + squaresInSide - penEntryDistanceFromOrigin - 1) / squaresInSide - 1) *
+            squaresInSide + penEntryDistanceFromOrigin;
+
+    return ret >= 0 ? ret : -1;
+}
+
+}
+
+//Nearest transition square of each kind strictly ahead of or behind a relative square, -1 if
+//there is none on the main track
+struct TransitionTables
+{
+    std::int8_t nextForwardJump[relSquaresCount] = {};
+    std::int8_t nextBackwardJump[relSquaresCount] = {};
+    std::int8_t nextPenEntry[relSquaresCount] = {};
+    std::int8_t previousForwardJump[relSquaresCount] = {};
+    std::int8_t previousBackwardJump[relSquaresCount] = {};
+    std::int8_t previousPenEntry[relSquaresCount] = {};
+};
+
+constexpr TransitionTables makeTransitionTables()
+{
+    using namespace _private;
+
+    TransitionTables ret;
+    int nextForward = -1, nextBackward = -1, nextPen = -1;
+    int previousForward = -1, previousBackward = -1, previousPen = -1;
+
+    for(int relSquare = relSquaresCount - 1; relSquare >= 0; --relSquare)
+    {
+        ret.nextForwardJump[relSquare] = nextForward;
+        ret.nextBackwardJump[relSquare] = nextBackward;
+        ret.nextPenEntry[relSquare] = nextPen;
+
+        if(relSquare < squaresInMain)
+        {
+            std::uint8_t flags = boardGeometry<GameRules>.squareFlags[relSquare];
+
+            nextForward = flags & ForwardJumpSquare ? relSquare : nextForward;
+            nextBackward = flags & BackwardJumpSquare ? relSquare : nextBackward;
+            nextPen = flags & PenEntrySquare ? relSquare : nextPen;
+        }
+    }
+
+    for(int relSquare = 0; relSquare < relSquaresCount; ++relSquare)
+    {
+        ret.previousForwardJump[relSquare] = previousForward;
+        ret.previousBackwardJump[relSquare] = previousBackward;
+        ret.previousPenEntry[relSquare] = previousPen;
+
+        if(relSquare < squaresInMain)
+        {
+            std::uint8_t flags = boardGeometry<GameRules>.squareFlags[relSquare];
+
+            previousForward = flags & ForwardJumpSquare ? relSquare : previousForward;
+            previousBackward = flags & BackwardJumpSquare ? relSquare : previousBackward;
+            previousPen = flags & PenEntrySquare ? relSquare : previousPen;
+        }
+    }
+
+    return ret;
+}
+
+constexpr TransitionTables transitionTables = makeTransitionTables();
+
+constexpr bool transitionTablesMatchFormulas()
+{
+    for(int relSquare = 0; relSquare < relSquaresCount; ++relSquare)
+    {
+        if(transitionTables.nextForwardJump[relSquare] != formula::nextForwardJump(relSquare) ||
+                transitionTables.nextBackwardJump[relSquare] !=
+                formula::nextBackwardJump(relSquare) ||
+                transitionTables.nextPenEntry[relSquare] != formula::nextPenEntry(relSquare) ||
+                transitionTables.previousForwardJump[relSquare] !=
+                formula::previousForwardJump(relSquare) ||
+                transitionTables.previousBackwardJump[relSquare] !=
+                formula::previousBackwardJump(relSquare) ||
+                transitionTables.previousPenEntry[relSquare] !=
+                formula::previousPenEntry(relSquare))
+            return false;
+    }
+    return true;
+}
+
+static_assert(transitionTablesMatchFormulas(),
+              "Transition tables should match the transition formulas");
+
+int nextForwardJump(int relSquare)
+{
+    assertRelSquareIsLegal(relSquare);
+    return transitionTables.nextForwardJump[relSquare];
+}
+
+int nextBackwardJump(int relSquare)
+{
+    assertRelSquareIsLegal(relSquare);
+    return transitionTables.nextBackwardJump[relSquare];
+}
+
+int nextPenEntry(int relSquare)
+{
+    assertRelSquareIsLegal(relSquare);
+    return transitionTables.nextPenEntry[relSquare];
+}
+
+int previousForwardJump(int relSquare)
+{
+    assertRelSquareIsLegal(relSquare);
+    return transitionTables.previousForwardJump[relSquare];
+}
+
+int previousBackwardJump(int relSquare)
+{
+    assertRelSquareIsLegal(relSquare);
+    return transitionTables.previousBackwardJump[relSquare];
+}
+
+int previousPenEntry(int relSquare)
+{
+    assertRelSquareIsLegal(relSquare);
+    return transitionTables.previousPenEntry[relSquare];
+}
+
+std::pair<int, TransitionKind> nextJump(int relSquare)
+{
+    assertRelSquareIsLegal(relSquare);
+
+    std::pair<int, TransitionKind> retCandidate1
+        {nextForwardJump(relSquare), TransitionKind::ForwardJump};
+    std::pair<int, TransitionKind> retCandidate2
+        {nextBackwardJump(relSquare), TransitionKind::BackwardJump};
+
+    if(retCandidate1.first == -1)
+    {
+        if(retCandidate2.first == -1)
+            return {-1, TransitionKind::None};
+        return retCandidate2;
+    }
+
+    if(retCandidate2.first == -1)
+        return retCandidate1;
+
+    return retCandidate1.first < retCandidate2.first ?
+                    retCandidate1 : retCandidate2;
+}
+
+std::pair<int, TransitionKind> previousJump(int relSquare)
+{
+    assertRelSquareIsLegal(relSquare);
+
+    std::pair<int, TransitionKind> retCandidate1
+        {previousForwardJump(relSquare), TransitionKind::ForwardJump};
+    std::pair<int, TransitionKind> retCandidate2
+        {previousBackwardJump(relSquare), TransitionKind::BackwardJump};
+
+    if(retCandidate1.first == -1 && retCandidate2.first == -1)
+        return {-1, TransitionKind::None};
+
+    return retCandidate1.first > retCandidate2.first ? retCandidate1 : retCandidate2;
+}
+
+std::pair<int, TransitionKind> nextTransition(int relSquare)
+{
+    assertRelSquareIsLegal(relSquare);
+
+    std::pair<int, TransitionKind> retCandidate1 = nextJump(relSquare);
+    std::pair<int, TransitionKind> retCandidate2{nextPenEntry(relSquare), TransitionKind::PenEntry};
+
+    if(retCandidate1.first == -1)
+    {
+        if(retCandidate2.first == -1)
+            return {-1, TransitionKind::None};
+        return retCandidate2;
+    }
+
+    if(retCandidate2.first == -1)
+        return retCandidate1;
+
+    return retCandidate1.first < retCandidate2.first ? retCandidate1 : retCandidate2;
+}
+
+std::pair<int, TransitionKind> previousTransition(int relSquare)
+{
+    assertRelSquareIsLegal(relSquare);
+
+    std::pair<int, TransitionKind> retCandidate1 = previousJump(relSquare);
+    std::pair<int, TransitionKind> retCandidate2
+        {previousPenEntry(relSquare), TransitionKind::PenEntry};
+
+    if(retCandidate1.first == -1 && retCandidate2.first == -1)
+        return {-1, TransitionKind::None};
+
+    return retCandidate1.first > retCandidate2.first ? retCandidate1 : retCandidate2;
+}
+
+int clearDistanceAhead(const Game & game, int player, int srcRelSquare, int maxDistance)
+{
+    int side = game.playerSettings().playerSideMap().at(player);
+
+    assertRelSquareIsLegal(srcRelSquare);
+    assert(maxDistance >= 0);
+
+    int distanceToCheck = srcRelSquare + maxDistance >= relSquaresCount ?
+                relSquaresCount - srcRelSquare - 1 :
+                maxDistance;
+
+    std::uint64_t occupancyAhead =
+            game.board().trackOccupancy(player, side, srcRelSquare + 1);
+
+    return std::min(countTrailingZeros(occupancyAhead), distanceToCheck);
+}
+
+//Chance of each ordered roll of the dice
+constexpr double rollChance()
+{
+    return 1. / DiceOutcomes<dieSideCount, dieCount>::rollCount();
+}
+
+//Chance of a given value showing on at least one of the dice
+constexpr double dieValueChance()
+{
+    double missChance = 1;
+
+    for(int i = 0; i < dieCount; ++i)
+        missChance *= double(dieSideCount - 1) / dieSideCount;
+
+    return 1 - missChance;
+}
+
+double pureDistance1DieChance(int distance)
+{
+    return distance <= 0 || distance > dieSideCount ? 0 : dieValueChance();
+}
+
+double pureDistance1DieChance(int distance, std::bitset<dieSideCount + 1> skippableDieValues)
+{
+    if(distance <= 0 || distance > dieSideCount)
+        return 0;
+
+    if constexpr(dieCount == 1)
+        return dieValueChance();
+
+    int unskippedValueCount = dieSideCount - distance -
+            (skippableDieValues >> (distance + 1)).count(); //TODO get rid of the warning
+
+    return dieValueChance() - unskippedValueCount * 2 * rollChance();
+}
+
+//Number of the ordered rolls of the dice with each sum
+constexpr std::array<int, dieCount * dieSideCount + 1> makeDiceSumWeights()
+{
+    std::array<int, dieCount * dieSideCount + 1> ret{};
+
+    for(const auto & outcome : diceOutcomes<dieSideCount, dieCount>)
+    {
+        int sum = 0;
+
+        for(int die : outcome.dice)
+            sum += die;
+        ret[sum] += outcome.weight;
+    }
+
+    return ret;
+}
+
+double pureDistance2DiceChance(int distance)
+{
+    constexpr auto sumWeights = makeDiceSumWeights();
+    constexpr int rollCount = DiceOutcomes<dieSideCount, dieCount>::rollCount();
+
+    return distance <= 0 || distance >= int(sumWeights.size()) ?
+                0 : double(sumWeights[distance]) / rollCount;
+}
+
+double directDistance1DieChance(const Game & game, int player, int srcRelSquare, int distance,
+                                std::bitset<dieSideCount + 1> skippableDieValues)
+{
+    assertRelSquareIsLegal(srcRelSquare);
+    assertRelSquareIsLegal(srcRelSquare + distance);
+
+    double ret = pureDistance1DieChance(distance, skippableDieValues);
+
+    if(ret == 0 || clearDistanceAhead(game, player, srcRelSquare, distance - 1) != distance - 1)
+        return 0;
+    return ret;
+}
+
+double directDistance2DiceChance(const Game & game, int player, int srcRelSquare, int distance)
+{
+    assertRelSquareIsLegal(srcRelSquare);
+    assertRelSquareIsLegal(srcRelSquare + distance);
+
+    double ret = pureDistance2DiceChance(distance);
+
+    if(ret == 0 || clearDistanceAhead(game, player, srcRelSquare, distance - 1) != distance - 1)
+        return 0;
+
+    int side = game.playerSettings().playerSideMap().at(player);
+    int transitionSrcRelSquare = srcRelSquare;
+    TransitionKind transitionKind;
+    int distanceToCheckFrom = (distance + 1) / 2;
+    int distanceToCheckTo = std::min(distance, dieSideCount + 1);
+
+    //Исключение тех 2к-комбинаций, которые не обеспечат distance из-за переходов в промежутке
+    //между srcRelSquare и srcRelSquare + distance
+
+    while(true)
+    {
+        std::tie(transitionSrcRelSquare, transitionKind) =
+                nextTransition(transitionSrcRelSquare);
+
+        if(transitionSrcRelSquare == -1)
+            break;
+
+        int srcToTransitionSrcDistance = transitionSrcRelSquare - srcRelSquare;
+
+        if(srcToTransitionSrcDistance < distanceToCheckFrom)
+            continue;
+        if(srcToTransitionSrcDistance >= distanceToCheckTo)
+            break;
+
+        bool transitionBlocked = false;
+
+        if(transitionKind != TransitionKind::PenEntry)
+        {
+            LocationId transitionSrcLocationId =
+                    Game::relSquareToLocationId(transitionSrcRelSquare, side, player);
+            LocationId transitionDestLocationId =
+                    {{Section::Kind::Main},
+                     Game::jumpDestinationSquare(transitionSrcLocationId.square)};
+            const Location & transitionDestLocation =
+                    game.board().location(transitionDestLocationId);
+
+            if(transitionDestLocation.hasPawns(player))
+                transitionBlocked = true;
+        }
+
+        if(!transitionBlocked)
+        {
+            if(srcToTransitionSrcDistance == distance / 2)
+                ret -= rollChance();
+            else
+                ret -= 2 * rollChance();
+        }
+    }
+
+    assert(ret >= 0);
+
+    return ret;
+}
+
+double distance1DieChance(const Game & game, int player, int srcRelSquare, int distance,
+                          std::bitset<dieSideCount + 1> skippableDieValues)
+{
+    assertRelSquareIsLegal(srcRelSquare);
+    assertRelSquareIsLegal(srcRelSquare + distance);
+
+    double ret = directDistance1DieChance(game, player, srcRelSquare, distance, skippableDieValues);
+    int destRelSquare = srcRelSquare + distance;
+    int jumpSrcRelSquare = destRelSquare > squaresInMain ?
+                -1 : Game::jumpDestinationSquare(destRelSquare);
+
+    if(jumpSrcRelSquare != -1)
+    {
+        int side = game.playerSettings().playerSideMap().at(player);
+        LocationId jumpSrcLocationId = Game::relSquareToLocationId(jumpSrcRelSquare, side, player);
+
+        if(!game.board().location(jumpSrcLocationId).hasPawns())
+            ret += directDistance1DieChance(game, player, srcRelSquare,
+                                            jumpSrcRelSquare - srcRelSquare, skippableDieValues);
+    }
+
+    return ret;
+}
+
+double distance2DiceChance(const Game & game, int player, int srcRelSquare, int distance)
+{
+    struct jumpInfo
+    {
+        int srcToJumpSrcDistance;
+        int jumpDestRelSquare;
+    };
+
+    assertRelSquareIsLegal(srcRelSquare);
+    assertRelSquareIsLegal(srcRelSquare + distance);
+
+    //A single die has no sum to move by
+    if constexpr(dieCount == 1)
+        return 0;
+
+    double ret = 0;
+    int side = game.playerSettings().playerSideMap().at(player);
+    int destRelSquares[2];
+    std::vector<jumpInfo> jumpInfos;
+
+    destRelSquares[0] = srcRelSquare + distance;
+    destRelSquares[1] = destRelSquares[0] > squaresInMain ?
+                -1 : Game::jumpDestinationSquare(destRelSquares[0]);
+
+    if(destRelSquares[1] != -1 &&
+            game.board().location(Game::relSquareToLocationId(destRelSquares[1], side, player)).
+            hasPawns())
+        destRelSquares[1] = -1;
+
+    int jumpSrcRelSquareCandidate = nextJump(srcRelSquare).first;
+    int distanceToCheck = clearDistanceAhead(game, player, srcRelSquare, dieSideCount + 1);
+
+    while(jumpSrcRelSquareCandidate != -1 &&
+          jumpSrcRelSquareCandidate - srcRelSquare < distanceToCheck)
+    {
+        LocationId jumpSrcLocationId =
+                Game::relSquareToLocationId(jumpSrcRelSquareCandidate, side, player);
+        LocationId jumpDestLocationId = {{Section::Kind::Main},
+                               Game::jumpDestinationSquare(jumpSrcLocationId.square)};
+        const Location & jumpDestLocation = game.board().location(jumpDestLocationId);
+
+        if(!jumpDestLocation.hasPawns())
+        {
+            int jumpDestRelSquare = Game::locationIdToRelSquare(jumpDestLocationId, side);
+
+            jumpInfos.push_back({jumpSrcRelSquareCandidate - srcRelSquare, jumpDestRelSquare});
+        }
+
+        jumpSrcRelSquareCandidate = nextJump(jumpSrcRelSquareCandidate).first;
+    }
+
+    for(int destRelSquare : destRelSquares)
+    {
+        if(destRelSquare == -1)
+            break;
+        ret += directDistance2DiceChance(game, player, srcRelSquare, destRelSquare - srcRelSquare);
+
+        for(auto [srcToJumpSrcDistance, jumpDestRelSquare] : jumpInfos)
+        {
+            int jumpDestToDestDistance = destRelSquare - jumpDestRelSquare;
+
+            if(jumpDestToDestDistance > 0 && srcToJumpSrcDistance >= jumpDestToDestDistance &&
+                    clearDistanceAhead(game, player, jumpDestRelSquare,
+                                       jumpDestToDestDistance - 1) == jumpDestToDestDistance - 1)
+            {
+                if(srcToJumpSrcDistance == jumpDestToDestDistance)
+                    ret += rollChance();
+                else
+                    ret += 2 * rollChance();
+            }
+        }
+    }
+
+    return ret;
+}
+
+double distanceChance(const Game & game, int player, int fromRelSquare, int distance,
+                      std::bitset<dieSideCount + 1> skippableDieValues)
+{
+    return distance1DieChance(game, player, fromRelSquare, distance, skippableDieValues) +
+            distance2DiceChance(game, player, fromRelSquare, distance);
+}
+
+std::unique_ptr<CommandTree> buildCommandTree(Game & game)
+{
+    std::unique_ptr<CommandTree> ret = std::make_unique<CommandTree>();
+
+    game.forEachTurnOutcome([&game, &ret](const TurnOutcome::Commands & commands)
+    {
+        ret->children.emplace_back(buildCommandTree(game));
+        ret->children.back()->commands = commands;
+    });
+
+    return ret;
+}
+
+//Terms of evaluatePosition for each pawn of a player, by the location of the pawn. A captive pawn
+//also adds pawnInCaptivity2Term to its captor.
+constexpr double pawnInMainSafeBonusTerm = 2;
+constexpr double pawnInPenTerm[sideCount][squaresInPen] = {{-12, -7, -2},
+                                                           {0, 5, 10},
+                                                           {12, 17, 22},
+                                                           {24, 29, 34}};
+constexpr double pawnInNestTerm = -6;
+constexpr double pawnInCaptivityTerm = -15;
+constexpr double pawnInCaptivity2Term = 5;
+constexpr double pawnInHouseTerm[pawnsPerPlayer] = {48, 49.5, 51, 52.5, 54};
+
+//Bounds of the term of a single pawn of its own player
+constexpr std::pair<double, double> pawnTermBounds()
+{
+    double min = std::min({0., pawnInNestTerm, pawnInCaptivityTerm});
+    double max = squaresInMain - 1 + pawnInMainSafeBonusTerm;
+
+    for(const auto & sideTerms : pawnInPenTerm)
+    {
+        for(double term : sideTerms)
+        {
+            min = std::min(min, term);
+            max = std::max(max, term);
+        }
+    }
+    for(double term : pawnInHouseTerm)
+    {
+        min = std::min(min, term);
+        max = std::max(max, term);
+    }
+
+    return {min, max};
+}
+
+PositionValue evaluatePosition(const Game & game)
+{
+    PositionValue ret;
+
+    ret.playerCount = game.playerSettings().playerCount();
+
+    for(const auto & [pawnId, pawn] : game.board().pawns())
+    {
+        const int & player = pawnId.player;
+        const int & side = game.playerSettings().playerSideMap().at(player);
+        const LocationId & locationId = pawn.locationId;
+        int relSide;
+
+        switch(locationId.section.kind)
+        {
+        case Section::Kind::Main:
+            ret.diffs[player] += Game::mainSquareToRelSquare(locationId.square, side);
+            if(Game::isLocationSafe(locationId))
+                ret.diffs[player] += pawnInMainSafeBonusTerm;
+            break;
+        case Section::Kind::Pen:
+            relSide = Game::sideToRelSide(locationId.section.index, side);
+
+            ret.diffs[player] += pawnInPenTerm[relSide][locationId.square];
+            break;
+        case Section::Kind::Nest:
+            ret.diffs[player] += pawnInNestTerm;
+            break;
+        case Section::Kind::Captivity:
+            ret.diffs[player] += pawnInCaptivityTerm;
+            ret.diffs[locationId.section.index] += pawnInCaptivity2Term;
+            break;
+        case Section::Kind::House:
+            ret.diffs[player] += pawnInHouseTerm[locationId.square];
+            break;
+        }
+    }
+
+    ret.sum = std::accumulate(std::begin(ret.diffs), std::begin(ret.diffs) + ret.playerCount, 0.);
+    return ret;
+}
+
+//The player scores highest with its pawns at the top term and holding every other pawn captive,
+//and lowest the other way round
+ScoreBounds playerScoreBounds(int playerCount)
+{
+    assert(playerCount >= 2);
+
+    auto [pawnMin, pawnMax] = pawnTermBounds();
+    Score max = pawnsPerPlayer * (pawnMax - pawnMin +
+                                  (playerCount - 1) * pawnInCaptivity2Term);
+    Score min = pawnsPerPlayer * (pawnMin - pawnMax -
+                                  pawnInCaptivity2Term / (playerCount - 1));
+
+    return {min, max};
+}
+
+Score boundedPlayerScore(PositionValue posValue, int player, ScoreBounds bounds)
+{
+    Score ret = playerScore(posValue, player);
+
+    assert(ret >= bounds.min && ret <= bounds.max);
+    return std::clamp(ret, bounds.min, bounds.max);
+}
+
+static Score evaluateLeaf(const Game & game, SearchContext & context)
+{
+    ++context.stats.evaluationCount;
+    return boundedPlayerScore(evaluatePosition(game), context.player, context.bounds);
+}
+
+static bool isSearchTimedOut(SearchContext & context)
+{
+    if(!context.timedOut && context.hasDeadline &&
+            std::chrono::steady_clock::now() >= context.deadline)
+        context.timedOut = true;
+    return context.timedOut;
+}
+
+//The visited set of a decision node nested in the ones entered so far; leaveDecision gives it
+//back
+static HashSet & enterDecision(SearchContext & context)
+{
+    if(context.decisionLevel == int(context.visitedHashes.size()))
+        context.visitedHashes.emplace_back();
+    return context.visitedHashes[context.decisionLevel++];
+}
+
+static void leaveDecision(SearchContext & context)
+{
+    --context.decisionLevel;
+}
+
+//The player searching takes the best outcome of its turns and the others the worst for it. The
+//scores are zero-sum, so with two players this is plain expectiminimax. Fails hard: the score
+//is alpha if it is at most alpha and beta if it is at least beta.
+static Score searchDecision(Game & game, int depth, Score alpha, Score beta,
+                            SearchContext & context)
+{
+    bool maximizing = game.playerActing() == context.player;
+    Score ret = maximizing ? alpha : beta;
+    bool hasOutcomes = false;
+    bool cutoff = false;
+
+    ++context.stats.decisionNodeCount;
+    game.forEachTurnOutcome([&](const TurnOutcome::Commands & /*commands*/)
+    {
+        hasOutcomes = true;
+        if(maximizing)
+        {
+            ret = std::max(ret, searchPosition(game, depth, ret, beta, context));
+            cutoff = ret >= beta;
+        }
+        else
+        {
+            ret = std::min(ret, searchPosition(game, depth, alpha, ret, context));
+            cutoff = ret <= alpha;
+        }
+        return !cutoff && !context.timedOut;
+    }, enterDecision(context));
+    leaveDecision(context);
+
+    return hasOutcomes ? ret : std::clamp(evaluateLeaf(game, context), alpha, beta);
+}
+
+//Score of only the turn outcome that scores best statically for the player acting. It bounds
+//the score of the position from below if the player searching acts in it and from above
+//otherwise.
+static Score probeDecision(Game & game, int depth, Score alpha, Score beta,
+                           SearchContext & context)
+{
+    bool maximizing = game.playerActing() == context.player;
+    std::optional<std::pair<Score, TurnOutcome::Commands>> best;
+
+    ++context.stats.decisionNodeCount;
+    game.forEachTurnOutcome([&](const TurnOutcome::Commands & commands)
+    {
+        Score score = evaluateLeaf(game, context);
+
+        if(!best || (maximizing ? score > best->first : score < best->first))
+            best.emplace(score, commands);
+    }, enterDecision(context));
+    leaveDecision(context);
+
+    if(!best)
+        return std::clamp(evaluateLeaf(game, context), alpha, beta);
+
+    FixedVector<UndoRecord, dieCount + 1> undoRecords;
+
+    for(const auto & [command, action] : best->second)
+    {
+        undoRecords.emplace_back();
+        game.doAction(action, undoRecords.back());
+    }
+
+    Score ret = searchPosition(game, depth, alpha, beta, context);
+
+    for(std::size_t index = undoRecords.size(); index > 0; --index)
+        game.undo(undoRecords[index - 1]);
+    return ret;
+}
+
+//Star1 narrows the window of each outcome to the scores that can still move the expected score
+//out of the window of the node, knowing that the unsearched outcomes score within the bounds of
+//the scorer. Star2 first probes every outcome with a single turn outcome of the player that
+//rolled, which bounds its score from one side and may cut the node before any full search.
+//Right above the last roll the turn outcomes are leaves, and a probe costs as much as the full
+//search of the outcome, so Star2 only probes higher up.
+static Score searchChance(Game & game, int depth, Score alpha, Score beta,
+                          SearchContext & context)
+{
+    constexpr auto & outcomes = diceOutcomes<dieSideCount, dieCount>;
+    const ScoreBounds & bounds = context.bounds;
+    std::array<Score, outcomes.size()> lowerBounds;
+    std::array<Score, outcomes.size()> upperBounds;
+    //Expected score if every outcome scored its lower or its upper bound
+    Score lowerSum = bounds.min;
+    Score upperSum = bounds.max;
+    Score ret = 0;
+
+    ++context.stats.chanceNodeCount;
+    lowerBounds.fill(bounds.min);
+    upperBounds.fill(bounds.max);
+
+    auto rollAnd = [&game](std::size_t index, auto function)
+    {
+        CompactAction action;
+        UndoRecord undoRecord;
+
+        game.createRollDiceAction(outcomes[index].dice, action);
+        game.doAction(action, undoRecord);
+        function();
+        game.undo(undoRecord);
+    };
+
+    if(context.chancePruning == ChancePruning::None)
+    {
+        for(std::size_t index = 0; index < outcomes.size(); ++index)
+        {
+            rollAnd(index, [&]
+            {
+                ret += outcomes[index].probability *
+                        searchPosition(game, depth - 1, bounds.min, bounds.max, context);
+            });
+        }
+        return ret;
+    }
+
+    if(context.chancePruning == ChancePruning::Star2 && depth > 1)
+    {
+        bool maximizing = game.playerActing() == context.player;
+
+        for(std::size_t index = 0; index < outcomes.size(); ++index)
+        {
+            double probability = outcomes[index].probability;
+
+            //The probe of an outcome of the player searching can only cut by failing high and
+            //the one of an opponent by failing low, so the other side of its window is open
+            rollAnd(index, [&]
+            {
+                if(maximizing)
+                {
+                    Score childBeta = (beta - lowerSum) / probability + bounds.min;
+                    Score score = probeDecision(game, depth - 1, bounds.min,
+                                                std::min(bounds.max, childBeta), context);
+
+                    lowerSum += probability * (score - bounds.min);
+                    lowerBounds[index] = score;
+                }
+                else
+                {
+                    Score childAlpha = (alpha - upperSum) / probability + bounds.max;
+                    Score score = probeDecision(game, depth - 1,
+                                                std::max(bounds.min, childAlpha), bounds.max,
+                                                context);
+
+                    upperSum -= probability * (bounds.max - score);
+                    upperBounds[index] = score;
+                }
+            });
+
+            if(lowerSum >= beta)
+                return beta;
+            if(upperSum <= alpha)
+                return alpha;
+        }
+    }
+
+    for(std::size_t index = 0; index < outcomes.size(); ++index)
+    {
+        double probability = outcomes[index].probability;
+        Score childAlpha = (alpha - upperSum) / probability + upperBounds[index];
+        Score childBeta = (beta - lowerSum) / probability + lowerBounds[index];
+        Score score = 0;
+
+        rollAnd(index, [&]
+        {
+            score = searchPosition(game, depth - 1, std::max(bounds.min, childAlpha),
+                                   std::min(bounds.max, childBeta), context);
+        });
+
+        if(score <= childAlpha)
+            return alpha;
+        if(score >= childBeta)
+            return beta;
+        lowerSum += probability * (score - lowerBounds[index]);
+        upperSum -= probability * (upperBounds[index] - score);
+        ret += probability * score;
+    }
+
+    return ret;
+}
+
+Score searchPosition(Game & game, int depth, Score alpha, Score beta, SearchContext & context)
+{
+    if(game.isFinished() || isSearchTimedOut(context))
+        return std::clamp(evaluateLeaf(game, context), alpha, beta);
+
+    LegalCommands commands = game.legalCommands();
+
+    if(commands[0].kind == Command::Kind::RollDice)
+    {
+        return depth == 0 ? std::clamp(evaluateLeaf(game, context), alpha, beta) :
+                            searchChance(game, depth, alpha, beta, context);
+    }
+    return searchDecision(game, depth, alpha, beta, context);
+}
+
+//The turn outcome of the player acting with the best score searched to the depth, and false if
+//the search timed out
+static bool searchRoot(Game & game, int depth, SearchContext & context,
+                       TurnOutcome::Commands & bestCommands)
+{
+    const ScoreBounds & bounds = context.bounds;
+    Score bestScore = bounds.min;
+    bool hasBest = false;
+
+    ++context.stats.decisionNodeCount;
+    game.forEachTurnOutcome([&](const TurnOutcome::Commands & commands)
+    {
+        //Without pruning every outcome gets the full window, and its exact score
+        Score alpha = context.chancePruning == ChancePruning::None ? bounds.min : bestScore;
+        Score score = searchPosition(game, depth, alpha, bounds.max, context);
+
+        if(!context.timedOut && (!hasBest || score > bestScore))
+        {
+            bestScore = score;
+            bestCommands = commands;
+            hasBest = true;
+        }
+        return !context.timedOut;
+    }, enterDecision(context));
+    leaveDecision(context);
+
+    return !context.timedOut;
+}
+
+CommandSequence chooseCommandSequence(Game & game, const SearchSettings & settings,
+                                      SearchStats & stats)
+{
+    SearchContext context;
+    TurnOutcome::Commands bestCommands;
+    CommandSequence sequence;
+
+    context.player = game.playerActing();
+    context.bounds = playerScoreBounds(game.playerSettings().playerCount());
+    context.chancePruning = settings.chancePruning;
+    context.deadline = std::chrono::steady_clock::now() + settings.timeBudget;
+
+    //Without a time budget only the full depth is searched. With one the search deepens a roll
+    //at a time, and the shallowest search, the current turn alone, always finishes.
+    for(int depth = settings.timeBudget.count() > 0 ? 0 : settings.depth; depth <= settings.depth;
+        ++depth)
+    {
+        TurnOutcome::Commands depthBestCommands;
+
+        if(!searchRoot(game, depth, context, depthBestCommands))
+            break;
+        bestCommands = depthBestCommands;
+        context.stats.depthReached = depth;
+        context.hasDeadline = settings.timeBudget.count() > 0;
+    }
+
+    for(const auto & [command, action] : bestCommands)
+        sequence.emplace_back(command, action.toAction());
+    stats = context.stats;
+    return sequence;
+}
+
+CommandSequence chooseCommandSequence(Game & game, const SearchSettings & settings)
+{
+    SearchStats stats;
+
+    return chooseCommandSequence(game, settings, stats);
+}
+
+CommandSequence chooseCommandSequence(Game & game)
+{
+    return chooseCommandSequence(game, SearchSettings{});
+}
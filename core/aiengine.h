@@ -0,0 +1,41 @@
+#ifndef AIENGINE_H
+#define AIENGINE_H
+
+#include <chrono>
+#include <list>
+#include <utility>
+
+#include "game.h"
+
+class AiEngine
+{
+public:
+    AiEngine();
+};
+
+//Pruning of the outcomes of the dice in the search, see Ballard's *-minimax
+enum class ChancePruning
+{
+    None,
+    Star1,
+    Star2
+};
+
+//How far the AI looks ahead. Depth is the number of rolls of the dice searched past the current
+//turn, each over all the dice outcomes. With a time budget the search deepens a roll at a time
+//up to depth and keeps the deepest one finished in time.
+struct SearchSettings
+{
+    int depth = 1;
+    std::chrono::milliseconds timeBudget{0};
+    ChancePruning chancePruning = ChancePruning::Star1;
+};
+
+//Commands the AI chooses for the player acting, up to the next roll of the dice or until the
+//action passes to another player
+std::list<std::pair<parchis::Command, parchis::ConstActionUptr>>
+        chooseCommandSequence(parchis::Game & game, const SearchSettings & settings);
+std::list<std::pair<parchis::Command, parchis::ConstActionUptr>>
+        chooseCommandSequence(parchis::Game & game);
+
+#endif // AIENGINE_H
@@ -0,0 +1,85 @@
+#ifndef AIENGINE_P_H
+#define AIENGINE_P_H
+
+#include <bitset>
+#include <chrono>
+#include <deque>
+#include <list>
+#include <memory>
+
+#include "aiengine.h"
+#include "game.h"
+
+//Internals of the AI engine, for the tools that benchmark and tune it
+
+//Each node is a distinct position at the end of a turn of the player acting in its parent, or
+//after a ransom hands the action to the captor
+struct CommandTree
+{
+    parchis::TurnOutcome::Commands commands;
+    std::list<std::unique_ptr<CommandTree>> children;
+};
+
+struct PositionValue
+{
+    int playerCount = 0;
+    double diffs[parchis::sideCount] = {0};
+    double sum = 99999999;// //TODO fix?
+};
+
+using Score = double;
+
+struct ScoreBounds
+{
+    Score min;
+    Score max;
+};
+
+Score playerScore(PositionValue posValue, int player);
+//Bounds of playerScore over every position of a game of playerCount players
+ScoreBounds playerScoreBounds(int playerCount);
+//playerScore within the bounds, which the pruning of the search relies on
+Score boundedPlayerScore(PositionValue posValue, int player, ScoreBounds bounds);
+PositionValue evaluatePosition(const parchis::Game & game);
+//Chance that the pawn of the player on the relative square reaches the square distance ahead
+//with the next roll
+double distanceChance(const parchis::Game & game, int player, int fromRelSquare, int distance,
+                      std::bitset<parchis::dieSideCount + 1> skippableDieValues);
+//Tree of the distinct turn outcomes of the player acting, down to the next roll of the dice
+std::unique_ptr<CommandTree> buildCommandTree(parchis::Game & game);
+
+struct SearchStats
+{
+    long decisionNodeCount = 0;
+    long chanceNodeCount = 0;
+    long evaluationCount = 0;
+    //Deepest search finished, -1 if none
+    int depthReached = -1;
+};
+
+struct SearchContext
+{
+    //The player searching, scores are from its point of view
+    int player = -1;
+    ScoreBounds bounds = {};
+    ChancePruning chancePruning = ChancePruning::None;
+    bool hasDeadline = false;
+    std::chrono::steady_clock::time_point deadline;
+    bool timedOut = false;
+    SearchStats stats;
+    //A visited set for each nested decision node, kept for the whole search so enumerating the
+    //turn outcomes doesn't allocate. A deque keeps the sets of the outer nodes in place as it
+    //grows.
+    std::deque<HashSet> visitedHashes;
+    int decisionLevel = 0;
+};
+
+//Expectiminimax score of the position with depth more rolls of the dice to search, within the
+//window (alpha, beta)
+Score searchPosition(parchis::Game & game, int depth, Score alpha, Score beta,
+                     SearchContext & context);
+std::list<std::pair<parchis::Command, parchis::ConstActionUptr>>
+        chooseCommandSequence(parchis::Game & game, const SearchSettings & settings,
+                              SearchStats & stats);
+
+#endif // AIENGINE_P_H
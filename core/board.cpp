@@ -0,0 +1,116 @@
+#include "board.h"
+
+#include <stdexcept>
+
+#include "zobrist.h"
+
+namespace parchis
+{
+
+PawnId Location::firstPawnId() const
+{
+    if(pawnCount() == 0)
+        throw std::out_of_range("Location contains no pawns");
+    return *pawnIds.begin();
+}
+
+void Board::reset()
+{
+    _playerCount = 0;
+    _pawns.fill(Pawn{});
+    for(Location & location : _locations)
+        location.pawnIds.clear();
+    _tiredPawnIds.clear();
+    _hash = 0;
+    _mainOccupancy.fill(0);
+    _houseOccupancy.fill(0);
+}
+
+void Board::initialize(int playerCount)
+{
+    assert(playerCount >= 0 && playerCount <= sideCount);
+
+    LocationId nestId{{Section::Kind::Nest}};
+    Location & nest = _locations[locationIdToIndex(nestId)];
+
+    reset();
+    _playerCount = playerCount;
+
+    for(int index = 0; index < boardPawnCount(playerCount); ++index)
+    {
+        PawnId pawnId = indexToPawnId(index);
+
+        _pawns[index] = Pawn{nestId, false};
+        nest.pawnIds.emplace(pawnId);
+    }
+
+    _hash = computeHash();
+}
+
+std::uint64_t Board::computeHash() const
+{
+    std::uint64_t ret = 0;
+
+    for(int index = 0; index < boardPawnCount(playerCount()); ++index)
+    {
+        ret ^= zobrist::pawnLocationKey(index, locationIdToIndex(_pawns[index].locationId));
+        if(_pawns[index].tired)
+            ret ^= zobrist::pawnTiredKey(index);
+    }
+
+    return ret;
+}
+
+void Board::relocatePawn(PawnId pawnId, LocationId destLocationId)
+{
+    int pawnIndex = pawnIdToIndex(pawnId);
+    int destLocationIndex = locationIdToIndex(destLocationId);
+    Pawn & pawn = _pawns[pawnIndex];
+    int srcLocationIndex = locationIdToIndex(pawn.locationId);
+    Location & destLocation = _locations[destLocationIndex];
+    Location & srcLocation = _locations[srcLocationIndex];
+
+    srcLocation.pawnIds.erase(pawnId);
+    destLocation.pawnIds.emplace(pawnId);
+    updateOccupancy(pawn.locationId);
+    updateOccupancy(destLocationId);
+    pawn.locationId = destLocationId;
+    _hash ^= zobrist::pawnLocationKey(pawnIndex, srcLocationIndex) ^
+             zobrist::pawnLocationKey(pawnIndex, destLocationIndex);
+}
+
+void Board::setPawnTired(PawnId pawnId, bool value)
+{
+    int pawnIndex = pawnIdToIndex(pawnId);
+    bool & pawnTired = _pawns[pawnIndex].tired;
+
+    if(value)
+        _tiredPawnIds.emplace(pawnId);
+    else
+        _tiredPawnIds.erase(pawnId);
+    if(pawnTired != value)
+        _hash ^= zobrist::pawnTiredKey(pawnIndex);
+    pawnTired = value;
+}
+
+void Board::updateOccupancy(LocationId locationId)
+{
+    bool occupied = location(locationId).hasPawns();
+
+    if(locationId.section.kind == Section::Kind::Main)
+    {
+        std::uint64_t bit = std::uint64_t{1} << locationId.square % 64;
+        std::uint64_t & mainOccupancy = _mainOccupancy[locationId.square / 64];
+
+        mainOccupancy = occupied ? mainOccupancy | bit : mainOccupancy & ~bit;
+    }
+    else if(locationId.section.kind == Section::Kind::House)
+    {
+        std::uint32_t bit = std::uint32_t{1} << locationId.square;
+        std::uint32_t & houseOccupancy = _houseOccupancy[locationId.section.index];
+
+        houseOccupancy = occupied ? houseOccupancy | bit : houseOccupancy & ~bit;
+    }
+}
+
+}
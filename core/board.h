@@ -0,0 +1,445 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#include "constants.h"
+#include "utilities.h"
+
+namespace parchis
+{
+
+struct PawnId;
+struct LessForPawnIds;
+struct LocationId;
+struct LessForLocationIds;
+struct Pawn;
+struct Location;
+class Board;
+
+}
+
+
+namespace std
+{
+
+template<>
+struct hash<parchis::PawnId>
+{
+    std::size_t operator()(parchis::PawnId pawnId) const;
+};
+
+template<>
+struct hash<parchis::LocationId>
+{
+    std::size_t operator()(parchis::LocationId locationId) const;
+};
+
+}
+
+
+namespace parchis
+{
+
+struct Section
+{
+    enum class Kind
+    {
+        Main,
+        Pen,
+        Nest,
+        Captivity,
+        House
+    };
+
+    Section(Kind _kind = Kind::Nest, int _index = -1) : kind{_kind}, index{_index} {}
+
+    Kind kind;
+    int index;
+};
+
+struct PawnId
+{
+    PawnId() : PawnId{-1, -1} {}
+    PawnId(int _player, int _index) : player{_player}, index{_index} {}
+
+    int player;
+    int index;
+};
+
+struct LessForPawnIds
+{
+    bool operator()(PawnId pawnId1, PawnId pawnId2) const
+    {
+        return std::tie(pawnId1.player, pawnId1.index) <
+               std::tie(pawnId2.player, pawnId2.index);
+    }
+};
+
+struct LocationId
+{
+    LocationId(Section _section = Section{}, int _square = -1)
+        : section{_section}, square{_square} {}
+
+    Section section;
+    int square;
+};
+
+struct LessForLocationIds
+{
+    bool operator()(LocationId locationId1, LocationId locationId2) const
+    {
+        return std::tie(
+                    locationId1.section.kind, locationId1.section.index, locationId1.square) <
+               std::tie(
+                    locationId2.section.kind, locationId2.section.index, locationId2.square);
+    }
+};
+
+struct Pawn
+{
+    Pawn(LocationId _locationId = LocationId{}, bool _tired = false)
+        : locationId{_locationId}, tired{_tired} {}
+
+    LocationId locationId;
+    bool tired;
+};
+
+//Pawns and locations are stored in flat arrays. Pawns are numbered player by player;
+//locations go in the order Main, Pen, Nest, then Captivity and House for each player,
+//so the pawns and the locations of the first playerCount players form a prefix.
+
+const int maxPawnCount = pawnsPerPlayer * sideCount;
+const int commonLocationCount = squaresInMain + squaresInPen * sideCount + 1;
+const int playerLocationCount = 1 + pawnsPerPlayer;
+const int maxLocationCount = commonLocationCount + playerLocationCount * sideCount;
+
+constexpr int boardPawnCount(int playerCount)
+{
+    return pawnsPerPlayer * playerCount;
+}
+
+constexpr int boardLocationCount(int playerCount)
+{
+    return commonLocationCount + playerLocationCount * playerCount;
+}
+
+inline int pawnIdToIndex(PawnId pawnId)
+{
+    assert(pawnId.player >= 0 && pawnId.player < sideCount);
+    assert(pawnId.index >= 0 && pawnId.index < pawnsPerPlayer);
+
+    return pawnId.player * pawnsPerPlayer + pawnId.index;
+}
+
+inline PawnId indexToPawnId(int index)
+{
+    return {index / pawnsPerPlayer, index % pawnsPerPlayer};
+}
+
+inline int locationIdToIndex(LocationId locationId)
+{
+    switch(locationId.section.kind)
+    {
+    case Section::Kind::Main:
+        assert(locationId.square >= 0 && locationId.square < squaresInMain);
+        return locationId.square;
+    case Section::Kind::Pen:
+        assert(locationId.square >= 0 && locationId.square < squaresInPen);
+        return squaresInMain + locationId.section.index * squaresInPen + locationId.square;
+    case Section::Kind::Nest:
+        return commonLocationCount - 1;
+    case Section::Kind::Captivity:
+        return commonLocationCount + locationId.section.index * playerLocationCount;
+    case Section::Kind::House:
+        assert(locationId.square >= 0 && locationId.square < pawnsPerPlayer);
+        return commonLocationCount + locationId.section.index * playerLocationCount + 1 +
+                locationId.square;
+    }
+
+    unreachable();
+}
+
+inline LocationId indexToLocationId(int index)
+{
+    if(index < squaresInMain)
+        return {{Section::Kind::Main}, index};
+    if(index < commonLocationCount - 1)
+    {
+        index -= squaresInMain;
+        return {{Section::Kind::Pen, index / squaresInPen}, index % squaresInPen};
+    }
+    if(index == commonLocationCount - 1)
+        return {{Section::Kind::Nest}};
+
+    index -= commonLocationCount;
+
+    int player = index / playerLocationCount;
+    int square = index % playerLocationCount;
+
+    if(square == 0)
+        return {{Section::Kind::Captivity, player}};
+    return {{Section::Kind::House, player}, square - 1};
+}
+
+//A set of pawns of the board kept as a bitmask over pawn indices. It is iterated in the
+//order of LessForPawnIds.
+class PawnIdSet
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = PawnId;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = PawnId;
+
+        const_iterator(std::uint64_t bits = 0) : _bits{bits} {}
+
+        PawnId operator*() const { return indexToPawnId(countTrailingZeros(_bits)); }
+        const_iterator & operator++() { _bits &= _bits - 1; return *this; }
+        const_iterator operator++(int) { const_iterator ret = *this; ++*this; return ret; }
+
+        bool operator==(const_iterator other) const { return _bits == other._bits; }
+        bool operator!=(const_iterator other) const { return _bits != other._bits; }
+
+    private:
+        std::uint64_t _bits;
+    };
+
+    const_iterator begin() const { return {_bits}; }
+    const_iterator end() const { return {}; }
+    std::size_t size() const { return static_cast<std::size_t>(popCount(_bits)); }
+    bool empty() const { return _bits == 0; }
+    bool contains(PawnId pawnId) const { return _bits & bit(pawnId); }
+    std::uint64_t bits() const { return _bits; }
+
+    void emplace(PawnId pawnId) { _bits |= bit(pawnId); }
+    void erase(PawnId pawnId) { _bits &= ~bit(pawnId); }
+    void clear() { _bits = 0; }
+
+    static std::uint64_t playerBits(int player)
+    {
+        return ((std::uint64_t{1} << pawnsPerPlayer) - 1) << (player * pawnsPerPlayer);
+    }
+
+private:
+    static std::uint64_t bit(PawnId pawnId)
+        { return std::uint64_t{1} << pawnIdToIndex(pawnId); }
+
+    std::uint64_t _bits = 0;
+};
+
+static_assert(maxPawnCount <= 64, "PawnIdSet can't hold that many pawns");
+
+struct Location
+{
+public:
+    int findPawnIndex(int player) const
+    {
+        std::uint64_t playerBits = pawnIds.bits() & PawnIdSet::playerBits(player);
+
+        return playerBits == 0 ? -1 : countTrailingZeros(playerBits) - player * pawnsPerPlayer;
+    }
+
+    PawnId firstPawnId() const;
+    std::size_t pawnCount(int player) const
+    {
+        return static_cast<std::size_t>(popCount(pawnIds.bits() & PawnIdSet::playerBits(player)));
+    }
+
+    std::size_t pawnCount() const { return pawnIds.size(); }
+    bool hasPawns(int player) const
+        { return (pawnIds.bits() & PawnIdSet::playerBits(player)) != 0; }
+    bool hasPawns() const { return !pawnIds.empty(); }
+
+    PawnIdSet pawnIds;
+};
+
+//Read-only view of the pawns or the locations of a board, iterated as (id, item) pairs
+template<class Id, class Item, Id (*indexToId)(int)>
+class BoardItems
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<Id, const Item &>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator(const Item * items, int index) : _items{items}, _index{index} {}
+
+        value_type operator*() const { return {indexToId(_index), _items[_index]}; }
+        const_iterator & operator++() { ++_index; return *this; }
+        const_iterator operator++(int) { const_iterator ret = *this; ++*this; return ret; }
+
+        bool operator==(const_iterator other) const { return _index == other._index; }
+        bool operator!=(const_iterator other) const { return _index != other._index; }
+
+    private:
+        const Item * _items;
+        int _index;
+    };
+
+    BoardItems(const Item * items, int count) : _items{items}, _count{count} {}
+
+    const_iterator begin() const { return {_items, 0}; }
+    const_iterator end() const { return {_items, _count}; }
+    std::size_t size() const { return static_cast<std::size_t>(_count); }
+
+private:
+    const Item * _items;
+    int _count;
+};
+
+class Board
+{
+public:
+    using Pawns = BoardItems<PawnId, Pawn, indexToPawnId>;
+    using Locations = BoardItems<LocationId, Location, indexToLocationId>;
+
+    int playerCount() const { return _playerCount; }
+    Pawns pawns() const { return {_pawns.data(), boardPawnCount(playerCount())}; }
+    Locations locations() const { return {_locations.data(), boardLocationCount(playerCount())}; }
+    //TODO: consider removing if unused
+    const PawnIdSet & tiredPawnIds() const { return _tiredPawnIds; }
+    const Pawn & pawn(PawnId pawnId) const { return _pawns[pawnIdToIndex(pawnId)]; }
+    const Location & location(LocationId locationId) const
+        { return _locations[locationIdToIndex(locationId)]; }
+    //Zobrist hash of the pawn locations and tired flags, kept up to date incrementally
+    std::uint64_t hash() const { return _hash; }
+    std::uint64_t computeHash() const;
+    //Bitboard of the occupied squares of the track of the player playing on the side, starting
+    //at fromRelSquare: bit i is set if the location of relative square fromRelSquare + i has pawns
+    std::uint64_t trackOccupancy(int player, int side, int fromRelSquare) const
+    {
+        if constexpr(relSquaresCount <= 64)
+        {
+            const std::uint64_t mainMask = (std::uint64_t{1} << squaresInMain) - 1;
+            std::uint64_t mainOccupancy = _mainOccupancy[0];
+            int shift = squaresInSide * side;
+            std::uint64_t relMain =
+                    (mainOccupancy >> shift | mainOccupancy << (squaresInMain - shift)) & mainMask;
+            std::uint64_t track = relMain | std::uint64_t{_houseOccupancy[player]} << squaresInMain;
+
+            return fromRelSquare >= 64 ? 0 : track >> fromRelSquare;
+        }
+        else
+        {
+            //The track doesn't fit in a word, gather the squares one by one
+            std::uint64_t ret = 0;
+            int toRelSquare = std::min(fromRelSquare + 64, relSquaresCount);
+
+            for(int relSquare = fromRelSquare; relSquare < toRelSquare; ++relSquare)
+            {
+                bool occupied;
+
+                if(relSquare < squaresInMain)
+                {
+                    int square = (relSquare + squaresInSide * side) % squaresInMain;
+
+                    occupied = _mainOccupancy[square / 64] >> (square % 64) & 1;
+                }
+                else
+                    occupied = _houseOccupancy[player] >> (relSquare - squaresInMain) & 1;
+
+                if(occupied)
+                    ret |= std::uint64_t{1} << (relSquare - fromRelSquare);
+            }
+
+            return ret;
+        }
+    }
+
+    void reset();
+    void initialize(int playerCount);
+
+    void relocatePawn(PawnId pawnId, LocationId destLocationId);
+    void setPawnTired(PawnId pawnId, bool value);
+
+private:
+    void updateOccupancy(LocationId locationId);
+
+    int _playerCount = 0;
+    std::array<Pawn, maxPawnCount> _pawns;
+    std::array<Location, maxLocationCount> _locations;
+    PawnIdSet _tiredPawnIds;
+    std::uint64_t _hash = 0;
+    std::array<std::uint64_t, (squaresInMain + 63) / 64> _mainOccupancy = {};
+    std::array<std::uint32_t, sideCount> _houseOccupancy = {};
+};
+
+static_assert(pawnsPerPlayer <= 32, "House doesn't fit in a bitboard");
+
+inline bool operator==(Section section1, Section section2)
+{
+    return std::tie(section1.kind, section1.index) == std::tie(section2.kind, section2.index);
+}
+
+inline bool operator!=(Section section1, Section section2)
+{
+    return !(section1 == section2);
+}
+
+inline bool operator==(PawnId pawnId1, PawnId pawnId2)
+{
+    return std::tie(pawnId1.player, pawnId1.index) == std::tie(pawnId2.player, pawnId2.index);
+}
+
+inline bool operator!=(PawnId pawnId1, PawnId pawnId2)
+{
+    return !(pawnId1 == pawnId2);
+}
+
+inline bool operator==(LocationId locationId1, LocationId locationId2)
+{
+    return std::tie(
+                locationId1.section.kind, locationId1.section.index, locationId1.square) ==
+            std::tie(
+                locationId2.section.kind, locationId2.section.index, locationId2.square);
+}
+
+inline bool operator!=(LocationId locationId1, LocationId locationId2)
+{
+    return !(locationId1 == locationId2);
+}
+
+}
+
+
+namespace std
+{
+
+inline std::size_t hash<parchis::PawnId>::operator()(parchis::PawnId pawnId) const
+{
+    std::size_t seed = pawnId.player;
+    hash_combine(seed, pawnId.index);
+
+    return seed;
+}
+
+inline std::size_t hash<parchis::LocationId>::operator()(parchis::LocationId locationId) const
+{
+    std::size_t seed = static_cast<std::size_t>(locationId.section.kind);
+    hash_combine(seed, locationId.section.index);
+    hash_combine(seed, locationId.square);
+
+    return seed;
+}
+
+}
+
+#endif // BOARD_H
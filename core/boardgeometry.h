@@ -0,0 +1,231 @@
+#ifndef BOARDGEOMETRY_H
+#define BOARDGEOMETRY_H
+
+#include <cstdint>
+
+#include "constants.h"
+
+//Lookup tables for the board geometry. The square helpers of Game only depend on the rules, so
+//the tables are filled once at compile time by walking the board side by side, and the
+//static_asserts at the bottom check every entry against the modulo formulas they replace.
+
+namespace parchis::_private
+{
+
+namespace formula
+{
+
+template<class Rules>
+constexpr int squareSide(int mainOrRelSquare)
+{
+    return ((mainOrRelSquare + Rules::squaresInSide / 2 - 1) % Rules::squaresInMain /
+            Rules::squaresInSide);
+}
+
+template<class Rules>
+constexpr int relSquareToMainSquare(int relSquare, int side)
+{
+    return (relSquare + Rules::squaresInSide * side) % Rules::squaresInMain;
+}
+
+template<class Rules>
+constexpr int mainSquareToRelSquare(int mainSquare, int side)
+{
+    return (mainSquare + Rules::squaresInSide * (Rules::sideCount - side)) % Rules::squaresInMain;
+}
+
+template<class Rules>
+constexpr int sideToRelSide(int side, int baseSide)
+{
+    return (Rules::sideCount + side - baseSide) % Rules::sideCount;
+}
+
+template<class Rules>
+constexpr int jumpDestinationSquare(int mainOrRelSquare)
+{
+    if(mainOrRelSquare % Rules::squaresInSide == Rules::jumpDistanceFromOrigin)
+        return relSquareToMainSquare<Rules>(Rules::squaresInMain - Rules::jumpDistanceFromOrigin,
+                                            (squareSide<Rules>(mainOrRelSquare) + 1) %
+                                            Rules::sideCount);
+    if(mainOrRelSquare % Rules::squaresInSide ==
+            Rules::squaresInSide - Rules::jumpDistanceFromOrigin)
+        return relSquareToMainSquare<Rules>(Rules::jumpDistanceFromOrigin,
+                                            (squareSide<Rules>(mainOrRelSquare) - 1 +
+                                             Rules::sideCount) % Rules::sideCount);
+    return -1;
+}
+
+}
+
+enum SquareFlag : std::uint8_t
+{
+    PenEntrySquare = 1 << 0,
+    PenExitSquare = 1 << 1,
+    SafeSquare = 1 << 2,
+    ForwardJumpSquare = 1 << 3,
+    BackwardJumpSquare = 1 << 4
+};
+
+//Tables indexed by square are valid for any main or relative square in [0, relSquaresCount)
+template<class Rules>
+struct BoardGeometry
+{
+    std::int8_t squareSide[Rules::relSquaresCount] = {};
+    std::int8_t jumpDestinationSquare[Rules::relSquaresCount] = {};
+    std::uint8_t squareFlags[Rules::relSquaresCount] = {};
+    std::int8_t relSquareToMainSquare[Rules::sideCount][Rules::relSquaresCount] = {};
+    std::int8_t mainSquareToRelSquare[Rules::sideCount][Rules::relSquaresCount] = {};
+    std::int8_t sideToRelSide[Rules::sideCount][Rules::sideCount] = {};
+    std::int8_t penEntrySquare[Rules::sideCount] = {};
+    std::int8_t penExitSquare[Rules::sideCount] = {};
+};
+
+template<class Rules>
+constexpr int wrapMainSquare(int square)
+{
+    return square < 0 ? square + Rules::squaresInMain :
+                        square >= Rules::squaresInMain ? square - Rules::squaresInMain : square;
+}
+
+template<class Rules>
+constexpr BoardGeometry<Rules> makeBoardGeometry()
+{
+    constexpr int squaresInSide = Rules::squaresInSide;
+    constexpr int squaresInMain = Rules::squaresInMain;
+    constexpr int sideCount = Rules::sideCount;
+    constexpr auto wrap = wrapMainSquare<Rules>;
+
+    static_assert(Rules::relSquaresCount <= 127,
+                  "Board geometry tables store squares in std::int8_t");
+
+    BoardGeometry<Rules> ret;
+
+    for(int side = 0; side < sideCount; ++side)
+    {
+        int origin = side * squaresInSide;
+        int mainSquare = origin;
+
+        for(int relSquare = 0; relSquare < squaresInMain; ++relSquare)
+        {
+            ret.relSquareToMainSquare[side][relSquare] = mainSquare;
+            ret.mainSquareToRelSquare[side][mainSquare] = relSquare;
+            mainSquare = wrap(mainSquare + 1);
+        }
+
+        //A side owns the squares from half a side behind its origin to half a side ahead of it
+        for(int offset = 1 - squaresInSide / 2; offset <= squaresInSide / 2; ++offset)
+            ret.squareSide[wrap(origin + offset)] = side;
+
+        for(int otherSide = 0; otherSide < sideCount; ++otherSide)
+        {
+            int relSide = otherSide - side;
+
+            ret.sideToRelSide[otherSide][side] = relSide < 0 ? relSide + sideCount : relSide;
+        }
+
+        int penEntrySquare = wrap(origin + Rules::penEntryDistanceFromOrigin);
+        int penExitSquare = wrap(origin + Rules::penExitDistanceFromOrigin);
+        int forwardJumpSquare = wrap(origin + Rules::jumpDistanceFromOrigin);
+        int backwardJumpSquare = wrap(origin + squaresInSide - Rules::jumpDistanceFromOrigin);
+
+        ret.penEntrySquare[side] = penEntrySquare;
+        ret.penExitSquare[side] = penExitSquare;
+        ret.squareFlags[penEntrySquare] |= PenEntrySquare;
+        ret.squareFlags[penExitSquare] |= PenExitSquare;
+        ret.squareFlags[wrap(origin + squaresInSide / 2)] |= SafeSquare;
+        ret.squareFlags[forwardJumpSquare] |= ForwardJumpSquare;
+        ret.squareFlags[backwardJumpSquare] |= BackwardJumpSquare;
+        ret.jumpDestinationSquare[forwardJumpSquare] = backwardJumpSquare;
+        ret.jumpDestinationSquare[backwardJumpSquare] = forwardJumpSquare;
+    }
+
+    for(int square = 0; square < squaresInMain; ++square)
+    {
+        if(!(ret.squareFlags[square] & (ForwardJumpSquare | BackwardJumpSquare)))
+            ret.jumpDestinationSquare[square] = -1;
+    }
+
+    //Relative squares past the main track reuse the entries of the first side
+    for(int square = squaresInMain; square < Rules::relSquaresCount; ++square)
+    {
+        ret.squareSide[square] = ret.squareSide[square - squaresInMain];
+        ret.jumpDestinationSquare[square] = ret.jumpDestinationSquare[square - squaresInMain];
+        ret.squareFlags[square] = ret.squareFlags[square - squaresInMain];
+
+        for(int side = 0; side < sideCount; ++side)
+        {
+            ret.relSquareToMainSquare[side][square] =
+                    ret.relSquareToMainSquare[side][square - squaresInMain];
+            ret.mainSquareToRelSquare[side][square] =
+                    ret.mainSquareToRelSquare[side][square - squaresInMain];
+        }
+    }
+
+    return ret;
+}
+
+template<class Rules>
+inline constexpr BoardGeometry<Rules> boardGeometry = makeBoardGeometry<Rules>();
+
+template<class Rules>
+constexpr bool boardGeometryMatchesFormulas()
+{
+    constexpr const BoardGeometry<Rules> & geometry = boardGeometry<Rules>;
+    constexpr int squaresInSide = Rules::squaresInSide;
+
+    for(int square = 0; square < Rules::relSquaresCount; ++square)
+    {
+        int squareInSide = square % squaresInSide;
+
+        if(geometry.squareSide[square] != formula::squareSide<Rules>(square) ||
+                geometry.jumpDestinationSquare[square] !=
+                formula::jumpDestinationSquare<Rules>(square) ||
+                bool(geometry.squareFlags[square] & PenEntrySquare) !=
+                (squareInSide == Rules::penEntryDistanceFromOrigin) ||
+                bool(geometry.squareFlags[square] & PenExitSquare) !=
+                (squareInSide == Rules::penExitDistanceFromOrigin) ||
+                bool(geometry.squareFlags[square] & SafeSquare) !=
+                (squareInSide == squaresInSide / 2) ||
+                bool(geometry.squareFlags[square] & ForwardJumpSquare) !=
+                (squareInSide == Rules::jumpDistanceFromOrigin) ||
+                bool(geometry.squareFlags[square] & BackwardJumpSquare) !=
+                (squareInSide == squaresInSide - Rules::jumpDistanceFromOrigin))
+            return false;
+    }
+
+    for(int side = 0; side < Rules::sideCount; ++side)
+    {
+        for(int square = 0; square < Rules::relSquaresCount; ++square)
+        {
+            if(geometry.relSquareToMainSquare[side][square] !=
+                    formula::relSquareToMainSquare<Rules>(square, side) ||
+                    geometry.mainSquareToRelSquare[side][square] !=
+                    formula::mainSquareToRelSquare<Rules>(square, side))
+                return false;
+        }
+
+        for(int otherSide = 0; otherSide < Rules::sideCount; ++otherSide)
+        {
+            if(geometry.sideToRelSide[otherSide][side] !=
+                    formula::sideToRelSide<Rules>(otherSide, side))
+                return false;
+        }
+
+        if(geometry.penEntrySquare[side] !=
+                formula::relSquareToMainSquare<Rules>(Rules::penEntryDistanceFromOrigin, side) ||
+                geometry.penExitSquare[side] !=
+                formula::relSquareToMainSquare<Rules>(Rules::penExitDistanceFromOrigin, side))
+            return false;
+    }
+
+    return true;
+}
+
+static_assert(boardGeometryMatchesFormulas<GameRules>(),
+              "Board geometry tables should match the square formulas");
+static_assert(boardGeometryMatchesFormulas<Rules<SixSideRules>>(),
+              "Board geometry tables should match the square formulas");
+
+}
+
+#endif // BOARDGEOMETRY_H
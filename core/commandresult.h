@@ -22,7 +22,8 @@ enum class RollDiceResultCode
     Success,
     FailGameFinished,
     FailPlayerFinished,
-    FailNotAllDiceUsed
+    FailNotAllDiceUsed,
+    FailDieOutOfRange
 };
 
 enum class MovePawnResultCode
@@ -0,0 +1,207 @@
+#include "compactaction.h"
+
+#include "actions.h"
+#include "gamestate.h"
+
+namespace parchis
+{
+
+void CompactAction::apply(GameState & gameState) const
+{
+    if(dice)
+        gameState.setDice(*dice);
+    for(auto [pawnIndex, tired] : tiredPawns)
+        gameState.board.setPawnTired(indexToPawnId(pawnIndex), tired);
+    for(auto [pawnIndex, locationIndex] : pawnRelocations)
+        gameState.board.relocatePawn(indexToPawnId(pawnIndex), indexToLocationId(locationIndex));
+    if(diceUsed)
+        gameState.setDiceUsed(*diceUsed);
+    if(actionAndTurn)
+        gameState.setActionAndTurn(actionAndTurn->playerActing, actionAndTurn->playerWithTurn);
+    if(playerFinished)
+        gameState.setPlayerFinished(playerFinished->player, playerFinished->finished);
+    if(gameFinished)
+        gameState.setFinished(*gameFinished);
+}
+
+CompactAction CompactAction::commit(GameState & gameState) const
+{
+    CompactAction inverseAction;
+    std::size_t tiredPawnCount = tiredPawns.size();
+    std::size_t pawnRelocationCount = pawnRelocations.size();
+
+    if(dice)
+    {
+        inverseAction.dice = gameState.dice;
+        gameState.setDice(*dice);
+    }
+
+    inverseAction.tiredPawns.resize(tiredPawnCount);
+    for(std::size_t index = 0; index < tiredPawnCount; ++index)
+    {
+        auto [pawnIndex, tired] = tiredPawns[index];
+        PawnId pawnId = indexToPawnId(pawnIndex);
+
+        inverseAction.tiredPawns[tiredPawnCount - 1 - index] =
+            {pawnIndex, gameState.board.pawn(pawnId).tired};
+        gameState.board.setPawnTired(pawnId, tired);
+    }
+
+    inverseAction.pawnRelocations.resize(pawnRelocationCount);
+    for(std::size_t index = 0; index < pawnRelocationCount; ++index)
+    {
+        auto [pawnIndex, locationIndex] = pawnRelocations[index];
+        PawnId pawnId = indexToPawnId(pawnIndex);
+        int srcLocationIndex = locationIdToIndex(gameState.board.pawn(pawnId).locationId);
+
+        inverseAction.pawnRelocations[pawnRelocationCount - 1 - index] =
+            {pawnIndex, std::uint8_t(srcLocationIndex)};
+        gameState.board.relocatePawn(pawnId, indexToLocationId(locationIndex));
+    }
+
+    if(diceUsed)
+    {
+        inverseAction.diceUsed = std::int8_t(gameState.diceUsed);
+        gameState.setDiceUsed(*diceUsed);
+    }
+
+    if(actionAndTurn)
+    {
+        inverseAction.actionAndTurn = {std::int8_t(gameState.playerActing),
+                                       std::int8_t(gameState.playerWithTurn)};
+        gameState.setActionAndTurn(actionAndTurn->playerActing, actionAndTurn->playerWithTurn);
+    }
+
+    if(playerFinished)
+    {
+        int player = playerFinished->player;
+
+        inverseAction.playerFinished =
+            {std::int8_t(player), gameState.playerSettings.isPlayerFinished(player)};
+        gameState.setPlayerFinished(player, playerFinished->finished);
+    }
+
+    if(gameFinished)
+    {
+        inverseAction.gameFinished = gameState.isFinished;
+        gameState.setFinished(*gameFinished);
+    }
+
+    return inverseAction;
+}
+
+template<class ActionT, class ... Args>
+static ActionUptr createAction(ActionArena * arena, Args && ... args)
+{
+    if(arena)
+        return Action::create<ActionT>(*arena, std::forward<Args>(args) ...);
+    return Action::create<ActionT>(std::forward<Args>(args) ...);
+}
+
+static ActionUptr toActionAux(const CompactAction & action, ActionArena * arena)
+{
+    std::pmr::memory_resource * resource = arena ? arena->resource() :
+                                                   std::pmr::get_default_resource();
+    ActionComplex::Container subactions{resource};
+
+    if(action.dice)
+        subactions.emplace_back(createAction<ActionDice>(arena, *action.dice));
+
+    if(!action.tiredPawns.empty())
+    {
+        ActionPawnTired::Container params{resource};
+
+        for(auto [pawnIndex, tired] : action.tiredPawns)
+            params.emplace_back(indexToPawnId(pawnIndex), tired);
+        subactions.emplace_back(createAction<ActionPawnTired>(arena, std::move(params)));
+    }
+
+    if(!action.pawnRelocations.empty())
+    {
+        ActionPawnRelocation::Container params{resource};
+
+        for(auto [pawnIndex, locationIndex] : action.pawnRelocations)
+            params.emplace_back(indexToPawnId(pawnIndex), indexToLocationId(locationIndex));
+        subactions.emplace_back(createAction<ActionPawnRelocation>(arena, std::move(params)));
+    }
+
+    if(action.diceUsed)
+        subactions.emplace_back(createAction<ActionDiceUsed>(arena, *action.diceUsed));
+    if(action.actionAndTurn)
+        subactions.emplace_back(createAction<ActionActionAndTurn>(
+                                    arena, action.actionAndTurn->playerActing,
+                                    action.actionAndTurn->playerWithTurn));
+    if(action.playerFinished)
+        subactions.emplace_back(createAction<ActionPlayerFinished>(
+                                    arena, action.playerFinished->player,
+                                    action.playerFinished->finished));
+    if(action.gameFinished)
+        subactions.emplace_back(createAction<ActionGameFinished>(arena, *action.gameFinished));
+
+    return createAction<ActionComplex>(arena, std::move(subactions));
+}
+
+ActionUptr CompactAction::toAction() const
+{
+    return toActionAux(*this, nullptr);
+}
+
+ActionUptr CompactAction::toAction(ActionArena & arena) const
+{
+    return toActionAux(*this, &arena);
+}
+
+void UndoRecord::record(const GameState & gameState, const CompactAction & action)
+{
+    std::uint64_t recordedPawnBits = 0;
+    auto recordPawn = [this, &gameState, &recordedPawnBits](std::uint8_t pawnIndex)
+    {
+        std::uint64_t pawnBit = std::uint64_t{1} << pawnIndex;
+
+        if(recordedPawnBits & pawnBit)
+            return;
+        recordedPawnBits |= pawnBit;
+
+        const Pawn & pawn = gameState.board.pawn(indexToPawnId(pawnIndex));
+
+        pawns.emplace_back(pawnIndex, std::uint8_t(locationIdToIndex(pawn.locationId)),
+                           pawn.tired);
+    };
+
+    pawns.clear();
+    for(auto [pawnIndex, tired] : action.tiredPawns)
+        recordPawn(pawnIndex);
+    for(auto [pawnIndex, locationIndex] : action.pawnRelocations)
+        recordPawn(pawnIndex);
+
+    dice = gameState.dice;
+    diceUsed = std::int8_t(gameState.diceUsed);
+    playerActing = std::int8_t(gameState.playerActing);
+    playerWithTurn = std::int8_t(gameState.playerWithTurn);
+    finishedPlayer = action.playerFinished ? action.playerFinished->player : -1;
+    playerFinished = finishedPlayer != -1 &&
+                     gameState.playerSettings.isPlayerFinished(finishedPlayer);
+    gameFinished = gameState.isFinished;
+}
+
+void UndoRecord::restore(GameState & gameState) const
+{
+    for(auto [pawnIndex, locationIndex, tired] : pawns)
+    {
+        PawnId pawnId = indexToPawnId(pawnIndex);
+        const Pawn & pawn = gameState.board.pawn(pawnId);
+
+        if(locationIdToIndex(pawn.locationId) != locationIndex)
+            gameState.board.relocatePawn(pawnId, indexToLocationId(locationIndex));
+        gameState.board.setPawnTired(pawnId, tired);
+    }
+
+    gameState.setDice(dice);
+    gameState.setDiceUsed(diceUsed);
+    gameState.setActionAndTurn(playerActing, playerWithTurn);
+    if(finishedPlayer != -1)
+        gameState.setPlayerFinished(finishedPlayer, playerFinished);
+    gameState.setFinished(gameFinished);
+}
+
+}
@@ -0,0 +1,118 @@
+#ifndef COMPACTACTION_H
+#define COMPACTACTION_H
+
+#include <cstdint>
+#include <optional>
+
+#include "action.h"
+#include "board.h"
+#include "constants.h"
+#include "dice.h"
+#include "utilities.h"
+
+namespace parchis
+{
+
+//Value-type counterpart of the ActionComplex trees built by Game. Every part is stored inline,
+//so building, committing and inverting it never touches the heap. The parts are applied in the
+//order of the members; toAction() turns it into the equivalent Action for the GUI and history.
+struct CompactAction
+{
+    struct Tired
+    {
+        std::uint8_t pawnIndex;
+        bool tired;
+    };
+
+    struct Relocation
+    {
+        std::uint8_t pawnIndex;
+        std::uint8_t locationIndex;
+    };
+
+    struct ActionAndTurn
+    {
+        std::int8_t playerActing;
+        std::int8_t playerWithTurn;
+    };
+
+    struct PlayerFinished
+    {
+        std::int8_t player;
+        bool finished;
+    };
+
+    //One command tires and relocates every pawn at most twice
+    using TiredPawns = FixedVector<Tired, 2 * maxPawnCount>;
+    using PawnRelocations = FixedVector<Relocation, 2 * maxPawnCount>;
+
+    void addPawnTired(PawnId pawnId, bool value)
+    {
+        tiredPawns.emplace_back(std::uint8_t(pawnIdToIndex(pawnId)), value);
+    }
+
+    void addPawnRelocation(PawnId pawnId, LocationId locationId)
+    {
+        pawnRelocations.emplace_back(std::uint8_t(pawnIdToIndex(pawnId)),
+                                     std::uint8_t(locationIdToIndex(locationId)));
+    }
+
+    //Back to the empty action, without touching the storage of the pawn lists
+    void clear()
+    {
+        dice.reset();
+        tiredPawns.clear();
+        pawnRelocations.clear();
+        diceUsed.reset();
+        actionAndTurn.reset();
+        playerFinished.reset();
+        gameFinished.reset();
+    }
+
+    void apply(GameState & gameState) const;
+    //Returns the inverse action
+    CompactAction commit(GameState & gameState) const;
+    ActionUptr toAction() const;
+    ActionUptr toAction(ActionArena & arena) const;
+
+    std::optional<Dice<dieCount>> dice;
+    TiredPawns tiredPawns;
+    PawnRelocations pawnRelocations;
+    std::optional<std::int8_t> diceUsed;
+    std::optional<ActionAndTurn> actionAndTurn;
+    std::optional<PlayerFinished> playerFinished;
+    std::optional<bool> gameFinished;
+};
+
+//Prior state of everything a CompactAction changes, written by Game::doAction and restored by
+//Game::undo. It has a fixed size, so make/unmake in search never touches the heap.
+struct UndoRecord
+{
+    struct PawnState
+    {
+        std::uint8_t pawnIndex;
+        std::uint8_t locationIndex;
+        bool tired;
+    };
+
+    void record(const GameState & gameState, const CompactAction & action);
+    void restore(GameState & gameState) const;
+
+    //Every pawn the action touches, once
+    FixedVector<PawnState, maxPawnCount> pawns;
+    Dice<dieCount> dice;
+    std::int8_t diceUsed;
+    std::int8_t playerActing;
+    std::int8_t playerWithTurn;
+    //-1 if the action doesn't change whether a player is finished
+    std::int8_t finishedPlayer;
+    bool playerFinished;
+    bool gameFinished;
+};
+
+static_assert(maxPawnCount <= 256 && maxLocationCount <= 256,
+              "CompactAction stores pawn and location indices in bytes");
+
+}
+
+#endif // COMPACTACTION_H
@@ -0,0 +1,80 @@
+#ifndef CONSTANTS_H
+#define CONSTANTS_H
+
+#include <array>
+
+namespace parchis
+{
+
+//Base rules of the classic game. A house-rule variant derives from it and redeclares the members
+//that differ, e.g. struct SingleDieRules : ClassicRules { static constexpr int dieCount = 1; };
+struct ClassicRules
+{
+    static constexpr int pawnsPerPlayer = 5;
+    static constexpr int dieSideCount = 6;
+    static constexpr int sideCount = 4;
+    static constexpr int dieCount = 2;
+    static constexpr int squaresInSide = 12;
+    static constexpr int squaresInPen = 3;
+    static constexpr int birthDieValue = 6;
+    static constexpr int ransomDieValue = 6;
+    static constexpr int penEntryDistanceFromOrigin = 3;
+    static constexpr int penExitDistanceFromOrigin = 5;
+    static constexpr int jumpDistanceFromOrigin = 2;
+    static constexpr std::array<int, squaresInPen> penDieValues = {1, 3, 6};
+};
+
+struct SixSideRules : ClassicRules
+{
+    static constexpr int sideCount = 6;
+};
+
+struct SingleDieRules : ClassicRules
+{
+    static constexpr int dieCount = 1;
+};
+
+//Complete rules: the base rules plus the values derived from them
+template<class BaseRules>
+struct Rules : BaseRules
+{
+    static constexpr int squaresInMain = BaseRules::squaresInSide * BaseRules::sideCount;
+    static constexpr int relSquaresCount = squaresInMain + BaseRules::pawnsPerPlayer;
+
+    static_assert(BaseRules::squaresInSide % 2 == 0, "squaresInSide should be even");
+    static_assert(BaseRules::squaresInPen > 1, "squaresInPen should be greater than 1");
+    static_assert(int(BaseRules::penDieValues.size()) == BaseRules::squaresInPen,
+                  "penDieValues should have a value for every pen square");
+    static_assert(BaseRules::penEntryDistanceFromOrigin > 0,
+                  "penEntryDistanceFromOrigin should be greater than 0");
+    static_assert(BaseRules::penExitDistanceFromOrigin <= BaseRules::squaresInSide / 2,
+                  "penExitDistanceFromOrigin should be less than or equal to squaresInSide / 2");
+};
+
+using DefaultRules = Rules<ClassicRules>;
+
+//Rules the engine is compiled for. A variant build defines PARCHIS_RULES as its base rules
+#ifdef PARCHIS_RULES
+using GameRules = Rules<PARCHIS_RULES>;
+#else
+using GameRules = DefaultRules;
+#endif
+
+const int pawnsPerPlayer = GameRules::pawnsPerPlayer;
+const int dieSideCount = GameRules::dieSideCount;
+const int sideCount = GameRules::sideCount;
+const int dieCount = GameRules::dieCount;
+const int squaresInSide = GameRules::squaresInSide;
+const int squaresInMain = GameRules::squaresInMain;
+const int squaresInPen = GameRules::squaresInPen;
+const int relSquaresCount = GameRules::relSquaresCount;
+const int birthDieValue = GameRules::birthDieValue;
+const int ransomDieValue = GameRules::ransomDieValue;
+const int penEntryDistanceFromOrigin = GameRules::penEntryDistanceFromOrigin;
+const int penExitDistanceFromOrigin = GameRules::penExitDistanceFromOrigin;
+const int jumpDistanceFromOrigin = GameRules::jumpDistanceFromOrigin;
+constexpr const std::array<int, squaresInPen> penDieValues = GameRules::penDieValues;
+
+}
+
+#endif // CONSTANTS_H
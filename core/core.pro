@@ -0,0 +1,58 @@
+#-------------------------------------------------
+#
+# Rules engine and AI of Parchis. It doesn't use Qt, so servers and batch tools can link it
+# without the GUI.
+#
+#-------------------------------------------------
+QMAKE_CXXFLAGS += -std=c++17
+QT -= core gui
+CONFIG -= qt
+CONFIG += staticlib optimize_full
+
+TARGET = parchiscore
+TEMPLATE = lib
+
+# The engine is the hot path of self-play and search, so release builds drop its asserts.
+CONFIG(release, debug|release): DEFINES += NDEBUG
+
+# Recompute the position hash from scratch after every Game::takeAction and assert that it
+# matches the incrementally updated one.
+#DEFINES += PARCHIS_CHECK_HASH
+
+
+SOURCES += \
+    game.cpp \
+    board.cpp \
+    playersettings.cpp \
+    gamestate.cpp \
+    dicegenerators.cpp \
+    actions.cpp \
+    aiengine.cpp \
+    packedgamestate.cpp \
+    compactaction.cpp \
+    actionarena.cpp \
+    rollfile.cpp
+
+HEADERS += \
+    game.h \
+    utilities.h \
+    visitor.h \
+    board.h \
+    playersettings.h \
+    gamestate.h \
+    constants.h \
+    dicegenerators.h \
+    dice.h \
+    actions.h \
+    action.h \
+    aiengine.h \
+    aiengine_p.h \
+    commandresult.h \
+    zobrist.h \
+    boardgeometry.h \
+    compactaction.h \
+    actionarena.h \
+    packedgamestate.h \
+    playerparticipation.h \
+    rollfile.h \
+    typelist.h
@@ -0,0 +1,119 @@
+#ifndef DICE_H
+#define DICE_H
+
+#include <array>
+#include <cstddef>
+
+namespace parchis
+{
+
+template <int dieCount>
+using Dice = std::array<int, dieCount>;
+
+//A distinct result of a roll. The dice are sorted in descending order, the way Game sorts rolled
+//dice.
+template <int dieCount>
+struct DiceOutcome
+{
+    Dice<dieCount> dice;
+    //Number of the equally likely ordered rolls giving these dice
+    int weight;
+    double probability;
+    //All the dice are equal, so the player keeps the turn
+    bool doubles;
+};
+
+//Every distinct outcome of rolling the dice, for chance nodes in search. Use the diceOutcomes
+//constant below.
+template <int dieSideCount, int dieCount>
+struct DiceOutcomes
+{
+    static constexpr int rollCount()
+    {
+        int ret = 1;
+
+        for(int index = 0; index < dieCount; ++index)
+            ret *= dieSideCount;
+        return ret;
+    }
+
+    //Multisets of dieCount values out of dieSideCount
+    static constexpr int outcomeCount()
+    {
+        long long ret = 1;
+
+        for(int index = 1; index <= dieCount; ++index)
+            ret = ret * (dieSideCount + index - 1) / index;
+        return static_cast<int>(ret);
+    }
+
+    using Items = std::array<DiceOutcome<dieCount>, outcomeCount()>;
+
+    constexpr typename Items::const_iterator begin() const { return items.begin(); }
+    constexpr typename Items::const_iterator end() const { return items.end(); }
+    constexpr std::size_t size() const { return items.size(); }
+    constexpr const DiceOutcome<dieCount> & operator[](std::size_t index) const
+        { return items[index]; }
+
+    Items items;
+};
+
+template <int dieSideCount, int dieCount>
+constexpr DiceOutcomes<dieSideCount, dieCount> makeDiceOutcomes()
+{
+    using Outcomes = DiceOutcomes<dieSideCount, dieCount>;
+
+    Outcomes ret{};
+    std::size_t outcomeIndex = 0;
+    int dieCountFactorial = 1;
+
+    for(int index = 2; index <= dieCount; ++index)
+        dieCountFactorial *= index;
+
+    //Each ordered roll sorted in descending order stands for its outcome
+    for(int roll = 0; roll < Outcomes::rollCount(); ++roll)
+    {
+        Dice<dieCount> dice{};
+        int rest = roll;
+        bool sorted = true;
+
+        for(int index = dieCount - 1; index >= 0; --index)
+        {
+            dice[index] = rest % dieSideCount + 1;
+            rest /= dieSideCount;
+        }
+
+        for(int index = 1; index < dieCount; ++index)
+            sorted = sorted && dice[index - 1] >= dice[index];
+
+        if(!sorted)
+            continue;
+
+        //dieCount! divided by the factorial of the length of every run of equal dice
+        int weight = dieCountFactorial;
+        int run = 1;
+
+        for(int index = 1; index < dieCount; ++index)
+        {
+            run = dice[index] == dice[index - 1] ? run + 1 : 1;
+            weight /= run;
+        }
+
+        ret.items[outcomeIndex++] = {dice, weight, double(weight) / Outcomes::rollCount(),
+                                     run == dieCount};
+    }
+
+    return ret;
+}
+
+template <int dieSideCount, int dieCount>
+inline constexpr DiceOutcomes<dieSideCount, dieCount> diceOutcomes =
+        makeDiceOutcomes<dieSideCount, dieCount>();
+
+static_assert(diceOutcomes<6, 2>.size() == 21 && diceOutcomes<6, 2>[0].weight == 1 &&
+              diceOutcomes<6, 2>[1].weight == 2 && diceOutcomes<6, 2>[0].doubles,
+              "Two six-sided dice have 21 outcomes with weights 1 and 2");
+
+}
+
+#endif // DICE_H
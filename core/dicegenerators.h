@@ -0,0 +1,173 @@
+#ifndef DICEGENERATORS_H
+#define DICEGENERATORS_H
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "dice.h"
+#include "utilities.h"
+
+namespace parchis::_private
+{
+
+class DefaultDieGeneratorBase
+{
+public:
+    DefaultDieGeneratorBase(int dieSideCount);
+    DefaultDieGeneratorBase(int dieSideCount, unsigned int seed);
+    DefaultDieGeneratorBase(const DefaultDieGeneratorBase & other);
+    DefaultDieGeneratorBase(DefaultDieGeneratorBase && other) noexcept
+        : _d{other._d} { other._d = nullptr; }
+
+    ~DefaultDieGeneratorBase();
+
+    DefaultDieGeneratorBase & operator=(const DefaultDieGeneratorBase & other);
+    DefaultDieGeneratorBase & operator=(DefaultDieGeneratorBase && other) noexcept
+        { swap(other); return *this; }
+
+    int operator()() noexcept;
+
+    void swap(DefaultDieGeneratorBase & other) noexcept
+        { std::swap(_d, other._d); }
+
+private:
+    struct Private;
+
+    Private * d() { return _d; }
+    const Private * d() const { return _d; }
+
+    Private * _d;
+};
+
+}
+
+namespace parchis
+{
+
+template <int dieCount>
+using DiceGenerator = std::function<Dice<dieCount>()>;
+
+template <int dieSideCount>
+class DefaultDieGenerator final : public _private::DefaultDieGeneratorBase
+{
+public:
+    DefaultDieGenerator() : DefaultDieGeneratorBase{dieSideCount} {}
+    DefaultDieGenerator(unsigned int seed) : DefaultDieGeneratorBase{dieSideCount, seed} {}
+
+    int operator()() { return DefaultDieGeneratorBase::operator()(); }
+};
+
+template <int dieSideCount, int dieCount>
+class DefaultDiceGenerator final
+{
+public:
+    DefaultDiceGenerator() = default;
+    DefaultDiceGenerator(unsigned int seed) : _dieGenerator{seed} {}
+
+    Dice<dieCount> operator()()
+    {
+        Dice<dieCount> dice;
+
+        for(auto & die : dice)
+            die = _dieGenerator();
+        return dice;
+    }
+
+private:
+    DefaultDieGenerator<dieSideCount> _dieGenerator;
+};
+
+//Counter-based generator for mass self-play. The value of the n-th roll is a hash of the stream
+//key and n, so the state is two integers, copying it is free, and a run is reproducible given
+//(seed, stream) whatever thread it runs on. All the dice come from one 64-bit draw.
+template <int dieSideCount, int dieCount>
+class CounterDiceGenerator final
+{
+public:
+    CounterDiceGenerator(std::uint64_t seed = 0, std::uint64_t stream = 0)
+        : _key{streamKey(seed, stream)} {}
+
+    Dice<dieCount> operator()()
+    {
+        //Draws below the threshold would make the lower rolls more likely
+        constexpr std::uint64_t threshold = (0 - rollCount) % rollCount;
+        std::uint64_t draw;
+
+        do
+        {
+            std::uint64_t state = _key + _counter++ * 0x9e3779b97f4a7c15;
+
+            draw = splitMix64(state);
+        } while(draw < threshold);
+
+        std::uint64_t roll = draw % rollCount;
+        Dice<dieCount> dice;
+
+        for(auto & die : dice)
+        {
+            die = static_cast<int>(roll % dieSideCount) + 1;
+            roll /= dieSideCount;
+        }
+        return dice;
+    }
+
+    void discard(std::uint64_t drawCount) { _counter += drawCount; }
+
+private:
+    static constexpr std::uint64_t rollCount = DiceOutcomes<dieSideCount, dieCount>::rollCount();
+
+    static constexpr std::uint64_t streamKey(std::uint64_t seed, std::uint64_t stream)
+    {
+        std::uint64_t state = stream;
+
+        state = seed ^ splitMix64(state);
+        return splitMix64(state);
+    }
+
+    std::uint64_t _key;
+    std::uint64_t _counter = 0;
+};
+
+//Dice source of Game. A CounterDiceGenerator is stored inline and called without indirection,
+//any other generator goes through DiceGenerator.
+template <int dieSideCount, int dieCount>
+class GameDiceGenerator final
+{
+public:
+    using Counter = CounterDiceGenerator<dieSideCount, dieCount>;
+
+    template <class T, class = std::enable_if_t<!std::is_same_v<T, GameDiceGenerator>>>
+    GameDiceGenerator(T generator)
+    {
+        if constexpr(std::is_same_v<T, Counter>)
+            _generator.template emplace<Counter>(generator);
+        else
+            _generator.template emplace<DiceGenerator<dieCount>>(std::move(generator));
+    }
+
+    Dice<dieCount> operator()()
+    {
+        if(auto * counter = std::get_if<Counter>(&_generator))
+            return (*counter)();
+        return std::get<DiceGenerator<dieCount>>(_generator)();
+    }
+
+private:
+    std::variant<Counter, DiceGenerator<dieCount>> _generator;
+};
+
+static_assert(std::is_trivially_copyable_v<CounterDiceGenerator<6, 2>>,
+              "CounterDiceGenerator is copied with every Game");
+
+inline void swap(parchis::_private::DefaultDieGeneratorBase & a,
+                 parchis::_private::DefaultDieGeneratorBase & b)
+{
+    a.swap(b);
+}
+
+}
+
+#endif // DICEGENERATORS_H
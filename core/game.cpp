@@ -0,0 +1,676 @@
+#include "game.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+#include "actions.h"
+
+//TODO: подумать насчёт uint-ов, сделать проверку на запредельные значения аргументов во всем проекте
+
+namespace parchis
+{
+
+static int commandCost(Command::Kind kind);
+static std::optional<LocationId> nextLocation(LocationId locationId, int side, int player,
+                                              int distance);
+static LocationId nextLocation(LocationId locationId, int side, int player);
+static std::pair<int, int> nextActionAndTurn(PlayerSettings::PlayersMap playersPlayingMap,
+                                             int playerActing, int playerWithTurn,
+                                             const Dice<dieCount> & dice, int diceUsed,
+                                             Command command);
+static void skipActionUnchecked(const Game & game, CompactAction & action);
+static void takeLocation(const Game & game, CompactAction & action,
+                         PawnId movedPawnId, LocationId destLocationId);
+static void penShift(const Game & game, CompactAction & action,
+                     PawnId movedPawnId, LocationId destLocationId);
+static void completeSubactions(PlayerSettings::PlayersMap playersPlayingMap,
+                               int playerActing, int playerWithTurn,
+                               const Dice<dieCount> & dice, int diceUsed,
+                               Command command, CompactAction & action);
+//The create*Action builders only check the command when action is null
+static SkipResultCode createSkipAction(const Game & game, CompactAction * action);
+template<class DiceSource>
+static RollDiceResultCode createRollDiceAction(const Game & game, DiceSource && diceSource,
+                                               CompactAction * action);
+static MovePawnResultCode createMovePawnAction(const Game & game, int pawnIndex,
+                                               CompactAction * action);
+static BirthResultCode createBirthAction(const Game & game, CompactAction * action);
+static RansomResultCode createRansomAction(const Game & game, int captorPlayer,
+                                           CompactAction * action);
+
+static int commandCost(Command::Kind kind)
+{
+    switch(kind)
+    {
+    case Command::Kind::RollDice:
+        return -dieCount;
+    case Command::Kind::Ransom:
+        return 0;
+    default:
+        return 1;
+    }
+}
+
+//Empty if the location is off the track or the end location doesn't exist. Overshooting the
+//house is an ordinary illegal move, so this doesn't throw.
+static std::optional<LocationId> nextLocation(LocationId locationId, int side, int player,
+                                              int distance)
+{
+    int relSquare = Game::locationIdToRelSquare(locationId, side);
+
+    if(relSquare == -1)
+        return std::nullopt;
+
+    int nextRelSquare = relSquare + distance;
+    LocationId ret = Game::relSquareToLocationId(nextRelSquare, side, player);
+
+    if(ret.section.kind == Section::Kind::Nest)
+        return std::nullopt;
+    return ret;
+}
+
+static LocationId nextLocation(LocationId locationId, int side, int player)
+{
+    if(locationId.section.kind == Section::Kind::Pen)
+    {
+        if(locationId.square < squaresInPen - 1)
+            return {locationId.section, locationId.square + 1};
+        return {{Section::Kind::Main}, Game::penExitSquare(locationId.section.index)};
+    }
+
+    std::optional<LocationId> ret = nextLocation(locationId, side, player, 1);
+
+    //Only used to shift pawns out of pens, which never reaches the end of the track
+    assert(ret);
+    return *ret;
+}
+
+static std::pair<int, int> nextActionAndTurn(PlayerSettings::PlayersMap playersPlayingMap,
+                                             int /*playerActing*/, int playerWithTurn,
+                                             const Dice<dieCount> & dice, int diceUsed,
+                                             Command command)
+{
+    if(diceUsed == dieCount - commandCost(command.kind))
+    {
+        bool isPlayerFinished = !playersPlayingMap.test(playerWithTurn);
+
+        auto compareDiceFun = [firstDie = dice.front()](int die) { return die == firstDie; };
+
+        int nextPlayer = (!isPlayerFinished &&
+                          std::all_of(dice.cbegin(), dice.cend(), compareDiceFun) ?
+                          playerWithTurn :
+                          PlayerParticipation::nextPlayerPlaying(playerWithTurn,
+                                                                 playersPlayingMap));
+
+        return {nextPlayer, nextPlayer};
+    }
+
+    if(command.kind == Command::Kind::Ransom)
+        return {command.param, playerWithTurn};
+    return {playerWithTurn, playerWithTurn};
+}
+
+static void skipActionUnchecked(const Game & game, CompactAction & action)
+{
+    completeSubactions(game.playerSettings().playersPlayingMap(), game.playerActing(),
+                       game.playerWithTurn(), game.dice(), game.diceUsed(),
+                       {Command::Kind::Skip}, action);
+}
+
+static void takeLocation(const Game & game, CompactAction & action,
+                         PawnId movedPawnId, LocationId destLocationId)
+{
+    //TODO : consider inversing the order of relocations (if I decide to make Location class
+    //without std::set)
+    const Location & destLocation = game.board().location(destLocationId);
+
+    action.addPawnRelocation(movedPawnId, destLocationId);
+
+    if(destLocation.hasPawns())
+    {
+        LocationId captivityId{{Section::Kind::Captivity, movedPawnId.player}};
+
+        action.addPawnTired(movedPawnId, true);
+
+        for(PawnId capturedPawnId : destLocation.pawnIds)
+        {
+            action.addPawnTired(capturedPawnId, false);
+            action.addPawnRelocation(capturedPawnId, captivityId);
+        }
+    }
+}
+
+static void penShift(const Game & game, CompactAction & action,
+                     PawnId movedPawnId, LocationId destLocationId)
+{
+    //TODO : consider inversing the order of relocations (if I decide to make Location class
+    //without std::set
+    PawnId pawnId = movedPawnId;
+    int playerSide = game.playerSettings().playerSideMap().at(pawnId.player);
+
+    while(true)
+    {
+        const Location & destLocation = game.board().location(destLocationId);
+
+        if(!destLocation.hasPawns() || (!Game::isLocationSafe(destLocationId) &&
+                                        !destLocation.hasPawns(pawnId.player)))
+        {
+            takeLocation(game, action, pawnId, destLocationId);
+            break;
+        }
+
+        action.addPawnRelocation(pawnId, destLocationId);
+        pawnId = destLocation.firstPawnId();
+        destLocationId = nextLocation(destLocationId, playerSide, pawnId.player);
+    }
+}
+
+static void completeSubactions(PlayerSettings::PlayersMap playersPlayingMap,
+                               int playerActing, int playerWithTurn,
+                               const Dice<dieCount> & dice, int diceUsed,
+                               Command command, CompactAction & action)
+{
+    auto [nextPlayerActing, nextPlayerWithTurn] =
+            nextActionAndTurn(playersPlayingMap, playerActing, playerWithTurn, dice,
+            diceUsed, command);
+
+    action.diceUsed = std::int8_t(diceUsed + commandCost(command.kind));
+    action.actionAndTurn = {std::int8_t(nextPlayerActing), std::int8_t(nextPlayerWithTurn)};
+}
+
+SkipResultCode createSkipAction(const Game & game, CompactAction * action)
+{
+    if(game.isFinished())
+        return SkipResultCode::FailGameFinished;
+    if(game.diceUsed() == dieCount)
+        return SkipResultCode::FailAllDiceUsed;
+
+    LegalCommands commands = game.legalCommands();
+
+    assert(!commands.empty());
+
+    if(commands[0] != Command{Command::Kind::Skip})
+        return SkipResultCode::FailSomeCommandsAvailable;
+
+    if(action)
+        skipActionUnchecked(game, *action);
+    return SkipResultCode::Success;
+}
+
+template<class DiceSource>
+RollDiceResultCode createRollDiceAction(const Game & game, DiceSource && diceSource,
+                                        CompactAction * action)
+{
+    if(game.isFinished())
+        return RollDiceResultCode::FailGameFinished;
+    if(game.playerSettings().isPlayerFinished(game.playerActing()))
+        return RollDiceResultCode::FailPlayerFinished;
+    if(game.diceUsed() < dieCount)
+        return RollDiceResultCode::FailNotAllDiceUsed;
+    if(!action)
+        return RollDiceResultCode::Success;
+
+    Dice<dieCount> newDice = diceSource();
+
+    if constexpr(dieCount > 2)
+    {
+        std::sort(newDice.begin(), newDice.end(), std::greater<>{});
+    }
+    else if constexpr(dieCount == 2)
+    {
+        Dice<dieCount>::value_type & die0 = newDice[0], & die1 = newDice[1];
+        if(die0 < die1)
+            std::swap(die0, die1);
+    }
+
+    action->dice = newDice;
+
+    for(PawnId tiredPawnId : game.board().tiredPawnIds())
+        action->addPawnTired(tiredPawnId, false);
+
+    completeSubactions(game.playerSettings().playersPlayingMap(), game.playerActing(),
+                       game.playerWithTurn(), game.dice(), game.diceUsed(),
+                       {Command::Kind::RollDice}, *action);
+    return RollDiceResultCode::Success;
+}
+
+MovePawnResultCode createMovePawnAction(const Game & game, int pawnIndex,
+                                        CompactAction * action)
+{
+    if(game.isFinished())
+        return MovePawnResultCode::FailGameFinished;
+    if(game.playerSettings().isPlayerFinished(game.playerActing()))
+        return MovePawnResultCode::FailPlayerFinished;
+    if(game.diceUsed() == dieCount)
+        return MovePawnResultCode::FailAllDiceUsed;
+
+    if(pawnIndex < 0 || pawnIndex >= pawnsPerPlayer)
+        throw std::out_of_range("Pawn index is out of range"); //TODO: return appropriate MovePawnResultCode?
+
+    PawnId movedPawnId{game.playerActing(), pawnIndex};
+    const Pawn & movedPawn = game.board().pawn(movedPawnId);
+
+    if(movedPawn.tired)
+        return MovePawnResultCode::FailTired;
+
+    const LocationId & srcLocationId = movedPawn.locationId;
+
+    if(srcLocationId.section.kind == Section::Kind::Nest)
+        return MovePawnResultCode::FailInNest;
+    if(srcLocationId.section.kind == Section::Kind::Captivity)
+        return MovePawnResultCode::FailCaptured;
+
+    int dieValue = game.dice().at(game.diceUsed());
+    int playerSide = game.playerSettings().playerSideMap().at(game.playerActing());
+    bool playerFinished = false;
+
+    if(srcLocationId.section.kind == Section::Kind::Pen)
+    {
+        if(dieValue != penDieValues.at(srcLocationId.square))
+            return MovePawnResultCode::FailInPenAndWrongDie;
+        if(!action)
+            return MovePawnResultCode::Success;
+        penShift(game, *action, movedPawnId,
+                 nextLocation(srcLocationId, playerSide, game.playerActing()));
+    }
+    else
+    {
+        std::optional<LocationId> nextLocationId = nextLocation(srcLocationId, playerSide,
+                                                                game.playerActing(), dieValue);
+
+        if(!nextLocationId)
+            return MovePawnResultCode::FailEndLocationNonexistent;
+
+        LocationId destLocationId = *nextLocationId;
+        const Location & destLocation = game.board().location(destLocationId);
+
+        if(destLocation.hasPawns(game.playerActing()))
+            return MovePawnResultCode::FailEndLocationWithFriendlyPawn;
+        if(destLocation.hasPawns() && destLocationId.section.kind == Section::Kind::Main
+                && Game::isLocationSafe(destLocationId))
+            return MovePawnResultCode::FailEndLocationSafeWithEnemyPawn;
+
+        int srcRelSquare = Game::locationIdToRelSquare(srcLocationId, playerSide);
+        std::uint64_t pathMask = (std::uint64_t{1} << (dieValue - 1)) - 1;
+
+        if(game.board().trackOccupancy(game.playerActing(), playerSide, srcRelSquare + 1) & pathMask)
+            return MovePawnResultCode::FailPathBlocked;
+        if(!action)
+            return MovePawnResultCode::Success;
+
+        takeLocation(game, *action, movedPawnId, destLocationId);
+
+        if(destLocationId.section.kind == Section::Kind::Main)
+        {
+            if(!destLocation.hasPawns())
+            {
+                if(Game::isSquarePenEntry(destLocationId.square))
+                {
+                    int side = Game::squareSide(destLocationId.square);
+
+                    penShift(game, *action, movedPawnId, {{Section::Kind::Pen, side}, 0});
+                }
+                else
+                {
+                    int jumpDestSquare = Game::jumpDestinationSquare(destLocationId.square);
+
+                    if(jumpDestSquare != -1)
+                    {
+                        LocationId jumpDestLocationId =
+                            {{Section::Kind::Main}, jumpDestSquare};
+                        const Location & jumpDestLocation =
+                                game.board().location(jumpDestLocationId);
+
+                        if(!jumpDestLocation.hasPawns(game.playerActing()))
+                            takeLocation(game, *action, movedPawnId, jumpDestLocationId);
+                    }
+                }
+            }
+        }
+        else if(destLocationId.square == 0)
+        {
+            playerFinished = true;
+
+            for(int square = 1; square < pawnsPerPlayer; ++square)
+            {
+                if(!game.board().location({{Section::Kind::House,
+                                          game.playerActing()}, square}).hasPawns())
+                {
+                    playerFinished = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    PlayerSettings::PlayersMap playersPlayingMap = game.playerSettings().playersPlayingMap();
+
+    if(playerFinished)
+        playersPlayingMap.reset(game.playerActing());
+
+    completeSubactions(playersPlayingMap,
+                       game.playerActing(), game.playerWithTurn(), game.dice(),
+                       game.diceUsed(), {Command::Kind::MovePawn, pawnIndex}, *action);
+
+    if(playerFinished)
+    {
+        action->playerFinished = {std::int8_t(game.playerActing()), true};
+
+        if(game.playerSettings().playersPlayingMap().count() <= 2)
+        {
+            action->gameFinished = true;
+        }
+    }
+
+    return MovePawnResultCode::Success;
+}
+
+BirthResultCode createBirthAction(const Game & game, CompactAction * action)
+{
+    if(game.isFinished())
+        return BirthResultCode::FailGameFinished;
+    if(game.playerSettings().isPlayerFinished(game.playerActing()))
+        return BirthResultCode::FailPlayerFinished;
+    if(game.diceUsed() == dieCount)
+        return BirthResultCode::FailAllDiceUsed;
+    if(game.playerWithTurn() != game.playerActing())
+        return BirthResultCode::FailOnlyAllowedOnYourTurn;
+
+    int dieValue = game.dice().at(game.diceUsed());
+
+    if(dieValue != birthDieValue)
+        return BirthResultCode::FailWrongDie;
+
+    LocationId nestId{{Section::Kind::Nest}};
+    const Location & nest = game.board().location(nestId);
+    int bornPawnIndex = nest.findPawnIndex(game.playerActing());
+
+    if(bornPawnIndex == -1)
+        return BirthResultCode::FailNoPawns;
+
+    LocationId originLocationId = Game::relSquareToLocationId(0,
+            game.playerSettings().playerSideMap().at(game.playerActing()),
+            game.playerActing());
+    const Location & originLocation = game.board().location(originLocationId);
+
+    if(originLocation.hasPawns(game.playerActing()))
+        return BirthResultCode::FailEndLocationWithFriendlyPawn;
+    if(originLocation.hasPawns() && Game::isLocationSafe(originLocationId))
+        return BirthResultCode::FailEndLocationSafeWithEnemyPawn;
+    if(!action)
+        return BirthResultCode::Success;
+
+    PawnId bornPawnId{game.playerActing(), bornPawnIndex};
+
+    takeLocation(game, *action, bornPawnId, originLocationId);
+    completeSubactions(game.playerSettings().playersPlayingMap(), game.playerActing(),
+                       game.playerWithTurn(), game.dice(), game.diceUsed(),
+                       {Command::Kind::Birth}, *action);
+    return BirthResultCode::Success;
+}
+
+RansomResultCode createRansomAction(const Game & game, int captorPlayer,
+                                    CompactAction * action)
+{
+    if(game.isFinished())
+        return RansomResultCode::FailGameFinished;
+    if(game.playerSettings().isPlayerFinished(game.playerActing()))
+        return RansomResultCode::FailPlayerFinished;
+    if(game.diceUsed() == dieCount)
+        return RansomResultCode::FailAllDiceUsed;
+    if(game.playerActing() == captorPlayer)
+        return RansomResultCode::FailSelf;
+    if(captorPlayer >= game.playerSettings().playerCount()) //TODO : check if captorPlayer < 0? do it in other places like this as well
+        return RansomResultCode::FailPlayerDoesNotExist;
+    if(game.playerWithTurn() != game.playerActing())
+        return RansomResultCode::FailOnlyAllowedOnYourTurn;
+
+    int dieValue = game.dice().at(game.diceUsed());
+
+    if(dieValue != ransomDieValue)
+        return RansomResultCode::FailWrongDie;
+
+    LocationId captivityId{{Section::Kind::Captivity, captorPlayer}};
+    const Location & captivity = game.board().location(captivityId);
+    int ransomedPawnIndex = captivity.findPawnIndex(game.playerActing());
+
+    if(ransomedPawnIndex == -1)
+        return RansomResultCode::FailNoPawns;
+    if(!action)
+        return RansomResultCode::Success;
+
+    PawnId ransomedPawnId{game.playerActing(), ransomedPawnIndex};
+    LocationId nestId{{Section::Kind::Nest}};
+
+    action->addPawnRelocation(ransomedPawnId, nestId);
+    completeSubactions(game.playerSettings().playersPlayingMap(), game.playerActing(),
+                       game.playerWithTurn(), game.dice(), game.diceUsed(),
+                       {Command::Kind::Ransom, captorPlayer}, *action);
+    return RansomResultCode::Success;
+}
+
+CommandResultCode Game::createCommandAction(Command command, CompactAction & action) const
+{
+    action.clear();
+    switch(command.kind)
+    {
+    case Command::Kind::Skip:
+        return createSkipAction(*this, &action);
+    case Command::Kind::RollDice:
+        return parchis::createRollDiceAction(*this, _diceGenerator, &action);
+    case Command::Kind::MovePawn:
+        return createMovePawnAction(*this, command.param, &action);
+    case Command::Kind::Birth:
+        return createBirthAction(*this, &action);
+    case Command::Kind::Ransom:
+        return createRansomAction(*this, command.param, &action);
+    default:
+        return {};
+    }
+}
+
+RollDiceResultCode Game::createRollDiceAction(const Dice<dieCount> & dice,
+                                              CompactAction & action) const
+{
+    action.clear();
+    for(int die : dice)
+    {
+        if(die < 1 || die > dieSideCount)
+            return RollDiceResultCode::FailDieOutOfRange;
+    }
+
+    return parchis::createRollDiceAction(*this, [&dice]() { return dice; }, &action);
+}
+
+std::pair<RollDiceResultCode, ActionUptr> Game::createRollDiceAction(
+        const Dice<dieCount> & dice) const
+{
+    CompactAction action;
+    RollDiceResultCode resultCode = createRollDiceAction(dice, action);
+
+    if(resultCode != RollDiceResultCode::Success)
+        return {resultCode, nullptr};
+    return {resultCode, action.toAction()};
+}
+
+std::pair<CommandResultCode, ActionUptr> Game::createCommandAction(Command command) const
+{
+    CompactAction action;
+    CommandResultCode resultCode = createCommandAction(command, action);
+
+    if(!resultCode.success())
+        return {resultCode, nullptr};
+    return {resultCode, action.toAction()};
+}
+
+std::pair<CommandResultCode, ActionUptr> Game::createCommandAction(Command command,
+                                                                   ActionArena & arena) const
+{
+    CompactAction action;
+    CommandResultCode resultCode = createCommandAction(command, action);
+
+    if(!resultCode.success())
+        return {resultCode, nullptr};
+    return {resultCode, action.toAction(arena)};
+}
+
+std::vector<std::pair<Command, ActionUptr>> Game::availableCommands() const
+{
+    std::vector<std::pair<Command, ActionUptr>> ret;
+
+    for(const auto & [command, action] : availableCompactCommands())
+    {
+        if(command.kind == Command::Kind::RollDice)
+            ret.emplace_back(command, nullptr);
+        else
+            ret.emplace_back(command, action.toAction());
+    }
+    return ret;
+}
+
+std::vector<std::pair<Command, ActionUptr>> Game::availableCommands(ActionArena & arena) const
+{
+    std::vector<std::pair<Command, ActionUptr>> ret;
+
+    for(const auto & [command, action] : availableCompactCommands())
+    {
+        if(command.kind == Command::Kind::RollDice)
+            ret.emplace_back(command, nullptr);
+        else
+            ret.emplace_back(command, action.toAction(arena));
+    }
+    return ret;
+}
+
+LegalCommands Game::legalCommands() const
+{
+    LegalCommands ret;
+
+    if(!isFinished())
+    {
+        bool isPlayerFinished = playerSettings().isPlayerFinished(playerActing());
+
+        if(!isPlayerFinished)
+        {
+            if(parchis::createRollDiceAction(*this, _diceGenerator, nullptr) ==
+                    RollDiceResultCode::Success)
+                ret.emplace_back(Command::Kind::RollDice);
+            else
+            {
+                for(int pawnIndex = 0; pawnIndex < pawnsPerPlayer; ++pawnIndex)
+                {
+                    if(createMovePawnAction(*this, pawnIndex, nullptr) ==
+                            MovePawnResultCode::Success)
+                        ret.emplace_back(Command::Kind::MovePawn, pawnIndex);
+                }
+
+                if(createBirthAction(*this, nullptr) == BirthResultCode::Success)
+                    ret.emplace_back(Command::Kind::Birth);
+
+                for(int player = 0; player < sideCount; ++player)
+                {
+                    if(createRansomAction(*this, player, nullptr) == RansomResultCode::Success)
+                        ret.emplace_back(Command::Kind::Ransom, player);
+                }
+            }
+        }
+
+        if(ret.empty() || isPlayerFinished)
+            ret.emplace_back(Command::Kind::Skip);
+    }
+
+    return ret;
+}
+
+std::vector<std::pair<Command, CompactAction>> Game::availableCompactCommands() const
+{
+    std::vector<std::pair<Command, CompactAction>> ret;
+
+    for(Command command : legalCommands())
+    {
+        CompactAction action;
+
+        //Skip is legal here, so don't list the commands again to check it
+        if(command.kind == Command::Kind::Skip)
+            skipActionUnchecked(*this, action);
+        else if(command.kind != Command::Kind::RollDice)
+        {
+            [[maybe_unused]] bool success = createCommandAction(command, action).success();
+
+            assert(success);
+        }
+        ret.emplace_back(command, action);
+    }
+
+    return ret;
+}
+
+std::vector<TurnOutcome> Game::turnOutcomes()
+{
+    std::vector<TurnOutcome> ret;
+
+    forEachTurnOutcome([this, &ret](const TurnOutcome::Commands & commands)
+    {
+        ret.push_back({commands, hash()});
+    });
+    return ret;
+}
+
+void Game::startOver(std::vector<int> playerSideMap)
+{
+    _gameState.reset();
+    _gameState.isFinished = playerSideMap.size() < 2;
+    _gameState.playerSettings.startOver(std::move(playerSideMap));
+    _gameState.board.initialize(playerSettings().playerCount());
+    _gameState.playerActing = 0;
+    _gameState.playerWithTurn = 0;
+    _gameState.resetHash();
+}
+
+ActionUptr Game::takeAction(const Action & action)
+{
+    ActionUptr inverseAction = action.commit(_gameState);
+
+#ifdef PARCHIS_CHECK_HASH
+    assert(_gameState.hash() == _gameState.computeHash());
+#endif
+
+    return inverseAction;
+}
+
+CompactAction Game::takeAction(const CompactAction & action)
+{
+    CompactAction inverseAction = action.commit(_gameState);
+
+#ifdef PARCHIS_CHECK_HASH
+    assert(_gameState.hash() == _gameState.computeHash());
+#endif
+
+    return inverseAction;
+}
+
+void Game::doAction(const CompactAction & action, UndoRecord & record)
+{
+    record.record(_gameState, action);
+    action.apply(_gameState);
+
+#ifdef PARCHIS_CHECK_HASH
+    assert(_gameState.hash() == _gameState.computeHash());
+#endif
+}
+
+void Game::undo(const UndoRecord & record)
+{
+    record.restore(_gameState);
+
+#ifdef PARCHIS_CHECK_HASH
+    assert(_gameState.hash() == _gameState.computeHash());
+#endif
+}
+
+}
@@ -0,0 +1,305 @@
+﻿#ifndef GAME_H
+#define GAME_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+
+#include "action.h"
+#include "boardgeometry.h"
+#include "commandresult.h"
+#include "compactaction.h"
+#include "constants.h"
+#include "dice.h"
+#include "dicegenerators.h"
+#include "gamestate.h"
+#include "packedgamestate.h"
+#include "utilities.h"
+
+//TODO : make a class or something that allows to temporarily change const game
+
+namespace parchis
+{
+
+class Board;
+class PlayerSettings;
+
+//At most a move for every pawn, a birth and a ransom from every captor, or else a single roll
+//or skip
+using LegalCommands = FixedVector<Command, pawnsPerPlayer + 1 + sideCount>;
+
+//A distinct position reached by the player acting with the current dice, see
+//Game::turnOutcomes
+struct TurnOutcome
+{
+    //A command for every die, and a ransom handing the action to the captor at most
+    using Commands = FixedVector<std::pair<Command, CompactAction>, dieCount + 1>;
+
+    Commands commands;
+    std::uint64_t hash;
+};
+
+class Game
+{
+public:
+    //Any dice generator; pass a CounterDiceGenerator to avoid the indirect call of DiceGenerator
+    Game(GameDiceGenerator<dieSideCount, dieCount> diceGenerator
+         = DefaultDiceGenerator<dieSideCount, dieCount>{})
+        : _diceGenerator{std::move(diceGenerator)}
+    {
+        reset();
+    }
+
+    Game(const PackedGameState & packedGameState,
+         GameDiceGenerator<dieSideCount, dieCount> diceGenerator
+         = DefaultDiceGenerator<dieSideCount, dieCount>{})
+        : _diceGenerator{std::move(diceGenerator)}
+    {
+        setPackedState(packedGameState);
+    }
+
+    bool isFinished() const { return _gameState.isFinished; }
+    const Board & board() const { return _gameState.board; }
+    int playerActing() const { return _gameState.playerActing; }
+    int playerWithTurn() const { return _gameState.playerWithTurn; }
+    const PlayerSettings & playerSettings() const { return _gameState.playerSettings; }
+    const Dice<dieCount> & dice() const { return _gameState.dice; }
+    int diceUsed() const { return _gameState.diceUsed; }
+    std::uint64_t hash() const { return _gameState.hash(); }
+    PackedGameState packedState() const { return PackedGameState::pack(_gameState); }
+
+    std::pair<CommandResultCode, ActionUptr> createCommandAction(Command command) const;
+    std::pair<CommandResultCode, ActionUptr> createCommandAction(Command command,
+                                                                 ActionArena & arena) const;
+    //Heap-free variant. The action is cleared first and filled only on success, so one object
+    //can be reused for many commands.
+    CommandResultCode createCommandAction(Command command, CompactAction & action) const;
+    //RollDice with the given dice instead of drawing them, e.g. to enumerate chance outcomes. The
+    //compact variant clears the action like createCommandAction.
+    std::pair<RollDiceResultCode, ActionUptr> createRollDiceAction(
+            const Dice<dieCount> & dice) const;
+    RollDiceResultCode createRollDiceAction(const Dice<dieCount> & dice,
+                                            CompactAction & action) const;
+    //Lists the commands without building their actions or touching the heap, in the same order
+    //as availableCommands(). Build the action of a chosen one with createCommandAction.
+    LegalCommands legalCommands() const;
+    //RollDice is a chance command: it is listed with an empty action, and the dice are drawn
+    //only when createCommandAction builds it
+    std::vector<std::pair<Command, ActionUptr>> availableCommands() const;
+    //The actions live in the arena, see ActionArena
+    std::vector<std::pair<Command, ActionUptr>> availableCommands(ActionArena & arena) const;
+    std::vector<std::pair<Command, CompactAction>> availableCompactCommands() const;
+    //Every distinct position the player acting can reach before the dice must be rolled, the
+    //action passes to a captor or the game finishes, each with the first command sequence
+    //found to reach it. Positions reached in several orders are listed once, by hash. Empty if
+    //the dice must be rolled. The game is left as it was.
+    std::vector<TurnOutcome> turnOutcomes();
+    //Calls the function with the game in each of the positions of turnOutcomes and the commands
+    //reaching it, instead of copying them out. The function must leave the game as it was.
+    //visitedHashes is cleared and used to skip the positions already reached; a search passes
+    //the same set to every call at a ply so enumerating doesn't allocate. A function returning
+    //bool stops the enumeration by returning false.
+    template <class Function>
+    void forEachTurnOutcome(Function && function, HashSet & visitedHashes);
+    template <class Function>
+    void forEachTurnOutcome(Function && function);
+
+    void startOver(std::vector<int> playerSideMap);
+    void reset() { startOver({}); }
+    void setPackedState(const PackedGameState & value) { value.unpack(_gameState); }
+    ActionUptr takeAction(const Action & action);
+    CompactAction takeAction(const CompactAction & action);
+    //Make/unmake for search: doAction saves what the action changes into the record and undo
+    //puts it back. Records must be undone in the reverse order of the actions.
+    void doAction(const CompactAction & action, UndoRecord & record);
+    void undo(const UndoRecord & record);
+    template<class T> void setDiceGenerator(T value) { _diceGenerator = value; }
+
+    //Square helpers take main or relative squares in [0, relSquaresCount) and sides in
+    //[0, sideCount), see boardgeometry.h. Squares past the main track wrap around it.
+    static int squareSide(int mainOrRelSquare)
+    {
+        assertSquareInRange(mainOrRelSquare);
+        return _private::boardGeometry<GameRules>.squareSide[mainOrRelSquare];
+    }
+
+    static int penEntrySquare(int side)
+    {
+        assertSideInRange(side);
+        return _private::boardGeometry<GameRules>.penEntrySquare[side];
+    }
+
+    static int penExitSquare(int side)
+    {
+        assertSideInRange(side);
+        return _private::boardGeometry<GameRules>.penExitSquare[side];
+    }
+
+    static int jumpDestinationSquare(int mainOrRelSquare)
+    {
+        assertSquareInRange(mainOrRelSquare);
+        return _private::boardGeometry<GameRules>.jumpDestinationSquare[mainOrRelSquare];
+    }
+
+    static bool isSquarePenEntry(int mainOrRelSquare)
+    {
+        assertSquareInRange(mainOrRelSquare);
+        return _private::boardGeometry<GameRules>.squareFlags[mainOrRelSquare] &
+               _private::PenEntrySquare;
+    }
+
+    static bool isSquarePenExit(int mainOrRelSquare)
+    {
+        assertSquareInRange(mainOrRelSquare);
+        return _private::boardGeometry<GameRules>.squareFlags[mainOrRelSquare] &
+               _private::PenExitSquare;
+    }
+
+    static bool isLocationSafe(LocationId locationId)
+    {
+        return locationId.section.kind != Section::Kind::Main ||
+               _private::boardGeometry<GameRules>.squareFlags[locationId.square] &
+               _private::SafeSquare;
+    }
+
+    static int sideToRelSide(int side, int baseSide)
+    {
+        assertSideInRange(side);
+        assertSideInRange(baseSide);
+        return _private::boardGeometry<GameRules>.sideToRelSide[side][baseSide];
+    }
+
+    static int relSideToSide(int relSide, int baseSide)
+    {
+        return (relSide + baseSide) % sideCount;
+    }
+
+    static int relSquareToMainSquare(int relSquare, int side)
+    {
+        assertSquareInRange(relSquare);
+        assertSideInRange(side);
+        return _private::boardGeometry<GameRules>.relSquareToMainSquare[side][relSquare];
+    }
+
+    static int mainSquareToRelSquare(int mainSquare, int side)
+    {
+        assertSquareInRange(mainSquare);
+        assertSideInRange(side);
+        return _private::boardGeometry<GameRules>.mainSquareToRelSquare[side][mainSquare];
+    }
+
+    static int locationIdToRelSquare(LocationId locationId, int side)
+    {
+        if(locationId.section.kind == Section::Kind::Main)
+            return Game::mainSquareToRelSquare(locationId.square, side);
+        else if(locationId.section.kind == Section::Kind::House)
+            return squaresInMain + locationId.square;
+        return -1;
+    }
+
+    //The nest stands for squares before the start or past the end of the track
+    static LocationId relSquareToLocationId(int relSquare, int side, int player)
+    {
+        if(relSquare < 0)
+            return {{Section::Kind::Nest}};
+        else if(relSquare < squaresInMain)
+            return {{Section::Kind::Main}, relSquareToMainSquare(relSquare, side)};
+        else if(relSquare < relSquaresCount)
+            return {{Section::Kind::House, player}, relSquare - squaresInMain};
+        return {{Section::Kind::Nest}};
+    }
+
+private:
+    static void assertSquareInRange([[maybe_unused]] int mainOrRelSquare)
+    {
+        assert(mainOrRelSquare >= 0 && mainOrRelSquare < relSquaresCount);
+    }
+
+    static void assertSideInRange([[maybe_unused]] int side)
+    {
+        assert(side >= 0 && side < sideCount);
+    }
+
+    GameState _gameState;
+    //Rolling the dice in the const createCommandAction advances it
+    mutable GameDiceGenerator<dieSideCount, dieCount> _diceGenerator;
+};
+
+namespace _private
+{
+
+//False if the function stopped the enumeration
+template <class Function>
+bool forEachTurnOutcomeAux(Game & game, int player, TurnOutcome::Commands & commands,
+                           HashSet & visitedHashes, Function & function)
+{
+    //Every outcome under a position was found the first time it was visited
+    if(!visitedHashes.insert(game.hash()))
+        return true;
+
+    LegalCommands legalCommands = game.legalCommands();
+
+    if(legalCommands.empty() || legalCommands[0].kind == Command::Kind::RollDice ||
+            game.playerActing() != player)
+    {
+        if constexpr(std::is_same_v<std::invoke_result_t<Function &,
+                                                         const TurnOutcome::Commands &>, bool>)
+            return function(commands);
+        else
+        {
+            function(commands);
+            return true;
+        }
+    }
+
+    for(Command command : legalCommands)
+    {
+        CompactAction action;
+        UndoRecord undoRecord;
+
+        game.createCommandAction(command, action);
+        commands.emplace_back(command, action);
+        game.doAction(action, undoRecord);
+
+        bool proceed = forEachTurnOutcomeAux(game, player, commands, visitedHashes, function);
+
+        game.undo(undoRecord);
+        commands.pop_back();
+        if(!proceed)
+            return false;
+    }
+    return true;
+}
+
+}
+
+template <class Function>
+void Game::forEachTurnOutcome(Function && function, HashSet & visitedHashes)
+{
+    LegalCommands commands = legalCommands();
+
+    if(commands.empty() || commands[0].kind == Command::Kind::RollDice)
+        return;
+
+    TurnOutcome::Commands sequence;
+
+    visitedHashes.clear();
+    _private::forEachTurnOutcomeAux(*this, playerActing(), sequence, visitedHashes, function);
+}
+
+template <class Function>
+void Game::forEachTurnOutcome(Function && function)
+{
+    HashSet visitedHashes;
+
+    forEachTurnOutcome(std::forward<Function>(function), visitedHashes);
+}
+
+}
+
+#endif // GAME_H
@@ -0,0 +1,76 @@
+#include "gamestate.h"
+
+#include "zobrist.h"
+
+namespace parchis
+{
+
+void GameState::reset()
+{
+    isFinished = true;
+    board.reset();
+    playerSettings.reset();
+    playerActing = -1;
+    playerWithTurn = -1;
+    dice.fill(0);
+    diceUsed = dieCount;
+    resetHash();
+}
+
+std::uint64_t GameState::computeHash() const
+{
+    std::uint64_t ret = board.computeHash();
+
+    if(isFinished)
+        ret ^= zobrist::gameFinishedKey();
+    ret ^= zobrist::playerActingKey(playerActing) ^ zobrist::playerWithTurnKey(playerWithTurn);
+    for(int dieIndex = 0; dieIndex < dieCount; ++dieIndex)
+        ret ^= zobrist::dieKey(dieIndex, dice[dieIndex]);
+    ret ^= zobrist::diceUsedKey(diceUsed);
+    for(int player = 0; player < playerSettings.playerCount(); ++player)
+    {
+        if(playerSettings.isPlayerFinished(player))
+            ret ^= zobrist::playerFinishedKey(player);
+    }
+
+    return ret;
+}
+
+void GameState::setFinished(bool value)
+{
+    if(isFinished != value)
+        _hash ^= zobrist::gameFinishedKey();
+    isFinished = value;
+}
+
+void GameState::setActionAndTurn(int newPlayerActing, int newPlayerWithTurn)
+{
+    _hash ^= zobrist::playerActingKey(playerActing) ^ zobrist::playerActingKey(newPlayerActing) ^
+             zobrist::playerWithTurnKey(playerWithTurn) ^
+             zobrist::playerWithTurnKey(newPlayerWithTurn);
+    playerActing = newPlayerActing;
+    playerWithTurn = newPlayerWithTurn;
+}
+
+void GameState::setDice(const Dice<dieCount> & value)
+{
+    for(int dieIndex = 0; dieIndex < dieCount; ++dieIndex)
+        _hash ^= zobrist::dieKey(dieIndex, dice[dieIndex]) ^
+                 zobrist::dieKey(dieIndex, value[dieIndex]);
+    dice = value;
+}
+
+void GameState::setDiceUsed(int value)
+{
+    _hash ^= zobrist::diceUsedKey(diceUsed) ^ zobrist::diceUsedKey(value);
+    diceUsed = value;
+}
+
+void GameState::setPlayerFinished(int player, bool value)
+{
+    if(playerSettings.isPlayerFinished(player) != value)
+        _hash ^= zobrist::playerFinishedKey(player);
+    playerSettings.setPlayerFinished(player, value);
+}
+
+}
@@ -0,0 +1,46 @@
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include <cstdint>
+
+#include "board.h"
+#include "constants.h"
+#include "dice.h"
+#include "playersettings.h"
+
+namespace parchis
+{
+
+struct GameState
+{
+    GameState() { reset(); }
+
+    void reset();
+
+    //Zobrist hash of the position. The setters below and the board keep it up to date;
+    //after writing the fields directly call resetHash()
+    std::uint64_t hash() const { return board.hash() ^ _hash; }
+    std::uint64_t computeHash() const;
+    void resetHash() { _hash = computeHash() ^ board.hash(); }
+
+    void setFinished(bool value);
+    void setActionAndTurn(int newPlayerActing, int newPlayerWithTurn);
+    void setDice(const Dice<dieCount> & value);
+    void setDiceUsed(int value);
+    void setPlayerFinished(int player, bool value);
+
+    bool isFinished;
+    Board board;
+    PlayerSettings playerSettings;
+    int playerActing;
+    int playerWithTurn;
+    Dice<dieCount> dice;
+    int diceUsed;
+
+private:
+    std::uint64_t _hash;
+};
+
+}
+
+#endif // GAMESTATE_H
@@ -0,0 +1,89 @@
+#include "packedgamestate.h"
+
+#include <vector>
+
+#include "gamestate.h"
+
+namespace parchis
+{
+
+PackedGameState PackedGameState::pack(const GameState & gameState)
+{
+    PackedGameState ret;
+    const PlayerSettings & playerSettings = gameState.playerSettings;
+    int playerCount = playerSettings.playerCount();
+    int finishedCount = static_cast<int>(playerSettings.playersFinishedList().size());
+
+    for(const auto & [pawnId, pawn] : gameState.board.pawns())
+    {
+        ret._bytes[pawnsOffset + pawnIdToIndex(pawnId)] =
+                static_cast<std::uint8_t>(locationIdToIndex(pawn.locationId) << 1 | pawn.tired);
+    }
+
+    for(int dieIndex = 0; dieIndex < dieCount; ++dieIndex)
+        ret._bytes[diceOffset + dieIndex] = static_cast<std::uint8_t>(gameState.dice[dieIndex]);
+
+    for(int player = 0; player < playerCount; ++player)
+    {
+        ret._bytes[playerSideMapOffset + player] =
+                static_cast<std::uint8_t>(playerSettings.playerSideMap()[player]);
+    }
+
+    for(int rank = 0; rank < finishedCount; ++rank)
+    {
+        ret._bytes[playersFinishedListOffset + rank] =
+                static_cast<std::uint8_t>(playerSettings.playersFinishedList()[rank]);
+    }
+
+    ret._bytes[playerCountsOffset] = static_cast<std::uint8_t>(playerCount | finishedCount << 4);
+    ret._bytes[playersOffset] = static_cast<std::uint8_t>((gameState.playerActing + 1) |
+                                                          (gameState.playerWithTurn + 1) << 4);
+    ret._bytes[diceUsedAndFinishedOffset] = static_cast<std::uint8_t>(gameState.diceUsed |
+                                                                      gameState.isFinished << 7);
+    return ret;
+}
+
+GameState PackedGameState::unpack() const
+{
+    GameState ret;
+
+    unpack(ret);
+    return ret;
+}
+
+void PackedGameState::unpack(GameState & gameState) const
+{
+    int playerCount = _bytes[playerCountsOffset] & 0xf;
+    int finishedCount = _bytes[playerCountsOffset] >> 4;
+    std::vector<int> playerSideMap(_bytes.cbegin() + playerSideMapOffset,
+                                   _bytes.cbegin() + playerSideMapOffset + playerCount);
+
+    gameState.reset();
+    gameState.playerSettings.startOver(std::move(playerSideMap));
+
+    for(int rank = 0; rank < finishedCount; ++rank)
+        gameState.playerSettings.setPlayerFinished(_bytes[playersFinishedListOffset + rank], true);
+
+    gameState.board.initialize(playerCount);
+
+    for(int index = 0; index < boardPawnCount(playerCount); ++index)
+    {
+        PawnId pawnId = indexToPawnId(index);
+        LocationId locationId = indexToLocationId(_bytes[pawnsOffset + index] >> 1);
+
+        if(locationId != LocationId{{Section::Kind::Nest}})
+            gameState.board.relocatePawn(pawnId, locationId);
+        gameState.board.setPawnTired(pawnId, _bytes[pawnsOffset + index] & 1);
+    }
+
+    for(int dieIndex = 0; dieIndex < dieCount; ++dieIndex)
+        gameState.dice[dieIndex] = _bytes[diceOffset + dieIndex];
+
+    gameState.playerActing = (_bytes[playersOffset] & 0xf) - 1;
+    gameState.playerWithTurn = (_bytes[playersOffset] >> 4) - 1;
+    gameState.diceUsed = _bytes[diceUsedAndFinishedOffset] & 0x7f;
+    gameState.isFinished = _bytes[diceUsedAndFinishedOffset] >> 7;
+    gameState.resetHash();
+}
+
+}
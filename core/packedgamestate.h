@@ -0,0 +1,86 @@
+#ifndef PACKEDGAMESTATE_H
+#define PACKEDGAMESTATE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "board.h"
+#include "constants.h"
+#include "utilities.h"
+
+namespace parchis
+{
+
+struct GameState;
+
+//A compact trivially copyable snapshot of GameState. Every pawn takes one byte (its location
+//index and tired flag), the rest of the state takes a few more, so a position can be copied,
+//compared and hashed as a plain block of bytes.
+class PackedGameState
+{
+public:
+    static PackedGameState pack(const GameState & gameState);
+    GameState unpack() const;
+    void unpack(GameState & gameState) const;
+
+    const std::uint8_t * data() const { return _bytes.data(); }
+    static constexpr std::size_t size() { return byteCount; }
+
+private:
+    //Layout of _bytes
+    //location index << 1 | tired, for every pawn
+    static constexpr std::size_t pawnsOffset = 0;
+    static constexpr std::size_t diceOffset = pawnsOffset + maxPawnCount;
+    static constexpr std::size_t playerSideMapOffset = diceOffset + dieCount;
+    static constexpr std::size_t playersFinishedListOffset = playerSideMapOffset + sideCount;
+    //playerCount | finished player count << 4
+    static constexpr std::size_t playerCountsOffset = playersFinishedListOffset + sideCount;
+    //playerActing + 1 | (playerWithTurn + 1) << 4
+    static constexpr std::size_t playersOffset = playerCountsOffset + 1;
+    //diceUsed | isFinished << 7
+    static constexpr std::size_t diceUsedAndFinishedOffset = playersOffset + 1;
+    static constexpr std::size_t byteCount = diceUsedAndFinishedOffset + 1;
+
+    std::array<std::uint8_t, byteCount> _bytes{};
+};
+
+static_assert(maxLocationCount <= 128, "location index doesn't fit in PackedGameState");
+static_assert(sideCount < 15, "player doesn't fit in PackedGameState");
+static_assert(dieCount < 128, "diceUsed doesn't fit in PackedGameState");
+static_assert(dieSideCount < 256, "die doesn't fit in PackedGameState");
+
+inline bool operator==(const PackedGameState & packedGameState1,
+                       const PackedGameState & packedGameState2)
+{
+    return std::equal(packedGameState1.data(), packedGameState1.data() + PackedGameState::size(),
+                      packedGameState2.data());
+}
+
+inline bool operator!=(const PackedGameState & packedGameState1,
+                       const PackedGameState & packedGameState2)
+{
+    return !(packedGameState1 == packedGameState2);
+}
+
+}
+
+
+namespace std
+{
+
+template<>
+struct hash<parchis::PackedGameState>
+{
+    std::size_t operator()(const parchis::PackedGameState & packedGameState) const
+    {
+        return hash_range(packedGameState.data(),
+                          packedGameState.data() + packedGameState.size());
+    }
+};
+
+}
+
+#endif // PACKEDGAMESTATE_H
@@ -0,0 +1,94 @@
+#ifndef PLAYERPARTICIPATION_H
+#define PLAYERPARTICIPATION_H
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "utilities.h"
+
+namespace parchis
+{
+    template<int maxNumberOfPlayers>
+    class PlayerParticipationBase
+    {
+        static_assert(maxNumberOfPlayers > 0 && maxNumberOfPlayers < 64,
+                      "maxNumberOfPlayers should be in range [1, 63]");
+
+    public:
+        using PlayersMap = std::bitset<maxNumberOfPlayers>;
+
+        PlayersMap playersStartedMap() const { return _playersStartedMap; }
+        PlayersMap playersFinishedMap() const { return _playersFinishedMap; }
+        PlayersMap playersPlayingMap() const { return playersStartedMap() & ~playersFinishedMap(); }
+        const std::vector<int> & playersFinishedList() const { return _playersFinishedList; }
+        int firstPlayerPlaying() const { return nextPlayerPlaying(-1); }
+        int nextPlayerPlaying(int player) const
+            { return nextPlayerPlaying(player, playersPlayingMap()); }
+
+        static int nextPlayerPlaying(int player, PlayersMap playersPlayingMap);
+
+        void reset() { startOver(PlayersMap{}); }
+        void startOver(PlayersMap playersStartingMap);
+        bool setPlayerFinished(int player, bool value);
+
+    private:
+        PlayersMap _playersStartedMap;
+        PlayersMap _playersFinishedMap;
+        std::vector<int> _playersFinishedList;
+    };
+
+    //Rotates the map so that the player after the given one becomes bit 0, then scans for
+    //the lowest set bit
+    template<int maxNumberOfPlayers>
+    int PlayerParticipationBase<maxNumberOfPlayers>::nextPlayerPlaying(
+            int player, PlayersMap playersPlayingMap)
+    {
+        const std::uint64_t mask = (std::uint64_t{1} << maxNumberOfPlayers) - 1;
+        std::uint64_t bits = playersPlayingMap.to_ullong();
+        int shift = player + 1;
+
+        if(bits == 0)
+            return -1;
+
+        std::uint64_t rotatedBits = (bits >> shift | bits << (maxNumberOfPlayers - shift)) & mask;
+
+        return (shift + countTrailingZeros(rotatedBits)) % maxNumberOfPlayers;
+    }
+
+    template<int maxNumberOfPlayers>
+    void PlayerParticipationBase<maxNumberOfPlayers>::startOver(PlayersMap playersStartingMap)
+    {
+        _playersStartedMap = playersStartingMap;
+        _playersFinishedMap.reset();
+        _playersFinishedList.clear();
+    }
+
+    template<int maxNumberOfPlayers>
+    bool PlayerParticipationBase<maxNumberOfPlayers>::setPlayerFinished(int player, bool value)
+    {
+        if(player < 0 || player >= maxNumberOfPlayers || !playersStartedMap()[player])
+            return false;
+
+        if(value)
+        {
+            if(playersFinishedMap()[player])
+                return false;
+            _playersFinishedMap.set(player);
+            _playersFinishedList.emplace_back(player);
+            return true;
+        }
+        else
+        {
+            if(!playersFinishedMap()[player])
+                return false;
+            _playersFinishedMap.reset(player);
+            _playersFinishedList.erase(std::find(_playersFinishedList.cbegin(),
+                                                 _playersFinishedList.cend(), player));
+            return true;
+        }
+    }
+}
+
+#endif // PLAYERPARTICIPATION_H
@@ -0,0 +1,23 @@
+#include "playersettings.h"
+
+namespace parchis
+{
+
+void PlayerSettings::startOver(std::vector<int> playerSideMap)
+{
+    PlayersMap playersStartingMap;
+
+    //TODO: size_t to int
+    _playerCount = playerSideMap.size();
+    _playerSideMap = std::move(playerSideMap);
+    for(int player = 0; player < playerCount(); ++player)
+        playersStartingMap.set(player);
+    _participation.startOver(playersStartingMap);
+}
+
+void PlayerSettings::setPlayerFinished(int player, bool value)
+{
+    _participation.setPlayerFinished(player, value);
+}
+
+}
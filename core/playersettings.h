@@ -0,0 +1,40 @@
+#ifndef PLAYERSETTINGS_H
+#define PLAYERSETTINGS_H
+
+#include <vector>
+
+#include "constants.h"
+#include "playerparticipation.h"
+
+namespace parchis
+{
+
+using PlayerParticipation = PlayerParticipationBase<sideCount>;
+
+class PlayerSettings
+{
+public:
+    using PlayersMap = PlayerParticipation::PlayersMap;
+
+    int playerCount() const { return _playerCount; }
+    const std::vector<int> & playerSideMap() const { return _playerSideMap; }
+    PlayersMap playersFinishedMap() const { return _participation.playersFinishedMap(); }
+    const std::vector<int> & playersFinishedList() const
+        { return _participation.playersFinishedList(); }
+    PlayersMap playersPlayingMap() const { return _participation.playersPlayingMap(); }
+    bool isPlayerFinished(int player) const { return playersFinishedMap().test(player); }
+    int firstPlayerPlaying() const { return _participation.firstPlayerPlaying(); }
+    int nextPlayerPlaying(int player) const { return _participation.nextPlayerPlaying(player); }
+
+    void reset() { startOver(std::vector<int>{}); }
+    void startOver(std::vector<int> playerSideMap);
+    void setPlayerFinished(int player, bool value);
+
+private:
+    int _playerCount = 0;
+    std::vector<int> _playerSideMap;
+    PlayerParticipation _participation;
+};
+
+}
+#endif // PLAYERSETTINGS_H
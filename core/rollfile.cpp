@@ -0,0 +1,98 @@
+#include "rollfile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace parchis
+{
+
+#ifdef _WIN32
+
+RollFile::RollFile(const std::string & fileName)
+{
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER size;
+
+    if(file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Cannot open the roll file " + fileName);
+    if(!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot read the size of the roll file " + fileName);
+    }
+
+    _size = static_cast<std::size_t>(size.QuadPart);
+
+    //An empty file can't be mapped, and there is nothing to map anyway
+    if(_size > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        //The view keeps the file mapped after the handles are closed
+        if(mapping)
+        {
+            _data = static_cast<const std::uint8_t *>(
+                        MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+
+    if(_size > 0 && !_data)
+        throw std::runtime_error("Cannot map the roll file " + fileName);
+}
+
+RollFile::~RollFile()
+{
+    if(_data)
+        UnmapViewOfFile(_data);
+}
+
+#else
+
+RollFile::RollFile(const std::string & fileName)
+{
+    int file = open(fileName.c_str(), O_RDONLY);
+    struct stat fileStat;
+
+    if(file == -1)
+        throw std::runtime_error("Cannot open the roll file " + fileName);
+    if(fstat(file, &fileStat) == -1)
+    {
+        close(file);
+        throw std::runtime_error("Cannot read the size of the roll file " + fileName);
+    }
+
+    _size = static_cast<std::size_t>(fileStat.st_size);
+
+    //An empty file can't be mapped, and there is nothing to map anyway
+    if(_size > 0)
+    {
+        void * data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        //The mapping stays valid after the file is closed
+        if(data != MAP_FAILED)
+            _data = static_cast<const std::uint8_t *>(data);
+    }
+    close(file);
+
+    if(_size > 0 && !_data)
+        throw std::runtime_error("Cannot map the roll file " + fileName);
+}
+
+RollFile::~RollFile()
+{
+    if(_data)
+        munmap(const_cast<std::uint8_t *>(_data), _size);
+}
+
+#endif
+
+}
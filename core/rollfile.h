@@ -0,0 +1,116 @@
+#ifndef ROLLFILE_H
+#define ROLLFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "dice.h"
+#include "dicegenerators.h"
+
+namespace parchis
+{
+
+//Read-only memory mapping of a roll file. Roll files have no header, just the rolls one after
+//another with a byte per die, so many games can be archived in one file and replayed from
+//their first roll.
+class RollFile
+{
+public:
+    explicit RollFile(const std::string & fileName);
+    ~RollFile();
+
+    RollFile(const RollFile &) = delete;
+    RollFile & operator=(const RollFile &) = delete;
+
+    const std::uint8_t * data() const { return _data; }
+    std::size_t size() const { return _size; }
+
+private:
+    const std::uint8_t * _data = nullptr;
+    std::size_t _size = 0;
+};
+
+//Plays back the rolls of a RollFile from the given roll on. Rolls are read from the mapping, so
+//there are no syscalls after the file is opened. Copies share the mapping. A byte that isn't a
+//die value throws without consuming the roll.
+template <int dieSideCount, int dieCount>
+class ReplayDiceGenerator final
+{
+public:
+    ReplayDiceGenerator(std::shared_ptr<const RollFile> file, std::size_t firstRoll = 0)
+        : _file{std::move(file)}, _offset{firstRoll * dieCount} {}
+
+    Dice<dieCount> operator()()
+    {
+        if(_offset > _file->size() || _file->size() - _offset < std::size_t{dieCount})
+            throw std::out_of_range("No rolls left in the roll file");
+
+        Dice<dieCount> dice;
+        const std::uint8_t * bytes = _file->data() + _offset;
+
+        for(int index = 0; index < dieCount; ++index)
+        {
+            if(bytes[index] < 1 || bytes[index] > dieSideCount)
+                throw std::runtime_error("Invalid die value " + std::to_string(bytes[index]) +
+                                         " in the roll file");
+            dice[index] = bytes[index];
+        }
+        _offset += dieCount;
+        return dice;
+    }
+
+    std::size_t nextRoll() const { return _offset / dieCount; }
+
+private:
+    std::shared_ptr<const RollFile> _file;
+    std::size_t _offset;
+};
+
+//Passes the rolls of another generator through and appends them to a stream in the roll file
+//format. The stream buffers the writes, and copies share it. A failed write throws, so a broken
+//recording doesn't go unnoticed.
+template <int dieCount>
+class RecordingDiceGenerator final
+{
+public:
+    RecordingDiceGenerator(DiceGenerator<dieCount> generator,
+                           std::shared_ptr<std::ostream> output)
+        : _generator{std::move(generator)}, _output{std::move(output)} {}
+    RecordingDiceGenerator(DiceGenerator<dieCount> generator, const std::string & fileName)
+        : RecordingDiceGenerator{std::move(generator), openRollFile(fileName)} {}
+
+    Dice<dieCount> operator()()
+    {
+        Dice<dieCount> dice = _generator();
+        char bytes[dieCount];
+
+        for(int index = 0; index < dieCount; ++index)
+            bytes[index] = static_cast<char>(dice[index]);
+        _output->write(bytes, dieCount);
+        if(!*_output)
+            throw std::runtime_error("Cannot write to the roll file");
+        return dice;
+    }
+
+private:
+    static std::shared_ptr<std::ostream> openRollFile(const std::string & fileName)
+    {
+        auto ret = std::make_shared<std::ofstream>(fileName, std::ios::binary);
+
+        if(!*ret)
+            throw std::runtime_error("Cannot open the roll file " + fileName);
+        return ret;
+    }
+
+    DiceGenerator<dieCount> _generator;
+    std::shared_ptr<std::ostream> _output;
+};
+
+}
+
+#endif // ROLLFILE_H
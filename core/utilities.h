@@ -0,0 +1,175 @@
+#ifndef UTILITIES_H
+#define UTILITIES_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <class T>
+inline void hash_combine(std::size_t & seed, T v)
+{
+    seed ^= static_cast<std::size_t>(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+template <class It>
+inline std::size_t hash_range(It first, It last)
+{
+    std::size_t seed = 0;
+
+    for(; first != last; ++first)
+    {
+        hash_combine(seed, *first);
+    }
+
+    return seed;
+}
+
+//Advances the state by a fixed step and returns a well-mixed function of it
+constexpr std::uint64_t splitMix64(std::uint64_t & state)
+{
+    std::uint64_t ret = (state += 0x9e3779b97f4a7c15);
+
+    ret = (ret ^ (ret >> 30)) * 0xbf58476d1ce4e5b9;
+    ret = (ret ^ (ret >> 27)) * 0x94d049bb133111eb;
+    return ret ^ (ret >> 31);
+}
+
+inline int countTrailingZeros(std::uint64_t value)
+{
+#if defined(__GNUC__)
+    return value == 0 ? 64 : __builtin_ctzll(value);
+#else
+    int ret = 0;
+
+    if(value == 0)
+        return 64;
+    for(; (value & 1) == 0; value >>= 1)
+        ++ret;
+    return ret;
+#endif
+}
+
+inline int popCount(std::uint64_t value)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(value);
+#else
+    int ret = 0;
+
+    for(; value != 0; value &= value - 1)
+        ++ret;
+    return ret;
+#endif
+}
+
+//Marks a path that valid input never takes, so the optimizer drops it
+[[noreturn]] inline void unreachable()
+{
+    assert(false);
+#if defined(__GNUC__)
+    __builtin_unreachable();
+#elif defined(_MSC_VER)
+    __assume(false);
+#endif
+}
+
+//Vector with inline storage for at most capacity items; it never allocates
+template <class T, std::size_t capacity>
+class FixedVector
+{
+public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    iterator begin() { return _items.data(); }
+    iterator end() { return _items.data() + _size; }
+    const_iterator begin() const { return _items.data(); }
+    const_iterator end() const { return _items.data() + _size; }
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    T & operator[](std::size_t index) { return _items[index]; }
+    const T & operator[](std::size_t index) const { return _items[index]; }
+    T & back() { return _items[_size - 1]; }
+    const T & back() const { return _items[_size - 1]; }
+
+    template <class ... Args>
+    T & emplace_back(Args && ... args)
+    {
+        assert(_size < capacity);
+        _items[_size] = T{std::forward<Args>(args) ...};
+        return _items[_size++];
+    }
+
+    void push_back(const T & value) { emplace_back(value); }
+    void pop_back() { assert(_size > 0); --_size; }
+    void resize(std::size_t size) { assert(size <= capacity); _size = size; }
+    void clear() { _size = 0; }
+
+private:
+    std::array<T, capacity> _items = {};
+    std::size_t _size = 0;
+};
+
+//Open-addressing set of well-mixed 64-bit hashes, such as Zobrist keys. clear() keeps the table,
+//so a set reused across searches stops allocating once it has grown to fit them.
+class HashSet
+{
+public:
+    //False if the hash was in the set already
+    bool insert(std::uint64_t hash)
+    {
+        //Zero marks the empty slots
+        if(hash == 0)
+            return !std::exchange(_hasZero, true);
+        if((_size + 1) * 2 > _slots.size())
+            grow();
+
+        std::size_t mask = _slots.size() - 1;
+
+        for(std::size_t index = hash & mask;; index = (index + 1) & mask)
+        {
+            if(_slots[index] == hash)
+                return false;
+            if(_slots[index] == 0)
+            {
+                _slots[index] = hash;
+                ++_size;
+                return true;
+            }
+        }
+    }
+
+    void clear()
+    {
+        if(_size > 0)
+            std::fill(_slots.begin(), _slots.end(), 0);
+        _size = 0;
+        _hasZero = false;
+    }
+
+private:
+    void grow()
+    {
+        std::vector<std::uint64_t> slots(std::max<std::size_t>(_slots.size() * 2, 64));
+
+        std::swap(slots, _slots);
+        _size = 0;
+        for(std::uint64_t hash : slots)
+        {
+            if(hash != 0)
+                insert(hash);
+        }
+    }
+
+    std::vector<std::uint64_t> _slots;
+    std::size_t _size = 0;
+    bool _hasZero = false;
+};
+
+#endif // UTILITIES_H
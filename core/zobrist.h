@@ -0,0 +1,110 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <array>
+#include <cstdint>
+
+#include "board.h"
+#include "constants.h"
+#include "utilities.h"
+
+//Zobrist keys for the incremental position hash of GameState. A position hash is the xor of
+//the keys of everything that is true in the position, so changing one part of the state
+//costs two xors. The keys are generated at compile time, so they are the same in every run.
+
+namespace parchis::_private
+{
+
+struct ZobristKeys
+{
+    std::uint64_t pawnLocation[maxPawnCount][maxLocationCount] = {};
+    std::uint64_t pawnTired[maxPawnCount] = {};
+    std::uint64_t die[dieCount][dieSideCount + 1] = {};
+    std::uint64_t diceUsed[dieCount + 1] = {};
+    std::uint64_t playerActing[sideCount + 1] = {};
+    std::uint64_t playerWithTurn[sideCount + 1] = {};
+    std::uint64_t playerFinished[sideCount] = {};
+    std::uint64_t gameFinished = 0;
+};
+
+constexpr ZobristKeys makeZobristKeys()
+{
+    ZobristKeys ret;
+    std::uint64_t state = 0x5061726368697321;
+
+    for(auto & pawnKeys : ret.pawnLocation)
+    {
+        for(auto & key : pawnKeys)
+            key = splitMix64(state);
+    }
+    for(auto & key : ret.pawnTired)
+        key = splitMix64(state);
+    for(auto & dieKeys : ret.die)
+    {
+        for(auto & key : dieKeys)
+            key = splitMix64(state);
+    }
+    for(auto & key : ret.diceUsed)
+        key = splitMix64(state);
+    for(auto & key : ret.playerActing)
+        key = splitMix64(state);
+    for(auto & key : ret.playerWithTurn)
+        key = splitMix64(state);
+    for(auto & key : ret.playerFinished)
+        key = splitMix64(state);
+    ret.gameFinished = splitMix64(state);
+
+    return ret;
+}
+
+inline constexpr ZobristKeys zobristKeys = makeZobristKeys();
+
+}
+
+namespace parchis::zobrist
+{
+
+inline std::uint64_t pawnLocationKey(int pawnIndex, int locationIndex)
+{
+    return _private::zobristKeys.pawnLocation[pawnIndex][locationIndex];
+}
+
+inline std::uint64_t pawnTiredKey(int pawnIndex)
+{
+    return _private::zobristKeys.pawnTired[pawnIndex];
+}
+
+inline std::uint64_t dieKey(int dieIndex, int value)
+{
+    return _private::zobristKeys.die[dieIndex][value];
+}
+
+inline std::uint64_t diceUsedKey(int diceUsed)
+{
+    return _private::zobristKeys.diceUsed[diceUsed];
+}
+
+//-1 is a valid player here, it means that nobody acts or has the turn
+inline std::uint64_t playerActingKey(int player)
+{
+    return _private::zobristKeys.playerActing[player + 1];
+}
+
+inline std::uint64_t playerWithTurnKey(int player)
+{
+    return _private::zobristKeys.playerWithTurn[player + 1];
+}
+
+inline std::uint64_t playerFinishedKey(int player)
+{
+    return _private::zobristKeys.playerFinished[player];
+}
+
+inline std::uint64_t gameFinishedKey()
+{
+    return _private::zobristKeys.gameFinished;
+}
+
+}
+
+#endif // ZOBRIST_H
@@ -37,7 +37,7 @@ double distanceChance(const parchis::Game & game, int player, int fromRelSquare,
 struct CommandTree
 {
     parchis::Command command;
-    parchis::ConstActionUptr action;
+    parchis::CompactAction action;
     std::list<std::unique_ptr<CommandTree>> children;
 };
 std::unique_ptr<CommandTree> buildCommandTree(parchis::Game & game);
@@ -60,10 +60,7 @@ using parchis::ActionGameFinished;
 static void movePawnActionsApply(Game * game, int pawnIndex,
                                  std::function<void(const Action &)> actionFun);
 
-class BornPawnSearchVisitor final :
-        public Loki::BaseVisitor,
-        public Loki::Visitor<ActionComplex, void, true>,
-        public Loki::Visitor<ActionPawnRelocation, void, true>
+class BornPawnSearchVisitor final
 {
 public:
     BornPawnSearchVisitor(GameWidget * gameWidget) : _gameWidget{gameWidget}
@@ -71,19 +68,19 @@ public:
 
     int bornPawnIndex() const { return _bornPawnIndex; }
 
-    void visit(const ActionComplex & action) override
+    void operator()(const ActionComplex & action)
     {
         _bornPawnIndex = -1;
 
         for(const auto & subAction : action.subActions())
         {
-            subAction->accept(*this);
+            parchis::visit(*subAction, *this);
             if(_bornPawnIndex != -1)
                 return;
         }
     }
 
-    void visit(const ActionPawnRelocation & action) override
+    void operator()(const ActionPawnRelocation & action)
     {
         _bornPawnIndex = -1;
 
@@ -103,10 +100,7 @@ private:
     int _bornPawnIndex = -1;
 };
 
-class ActionAnimationVisitor final :
-        public Loki::BaseVisitor,
-        public Loki::Visitor<ActionComplex, void, true>,
-        public Loki::Visitor<ActionPawnRelocation, void, true>
+class ActionAnimationVisitor final
 {
 public:
     ActionAnimationVisitor(GameWidget * gameWidget)
@@ -116,7 +110,7 @@ public:
 
     std::unique_ptr<QAbstractAnimation> & animation() { return _animation; }
 
-    void visit(const ActionComplex & action) override
+    void operator()(const ActionComplex & action)
     {
         _animation = nullptr;
 
@@ -128,7 +122,7 @@ public:
 
         for(const auto & subAction : action.subActions())
         {
-            subAction->accept(*this);
+            parchis::visit(*subAction, *this);
             if(_animation)
                 ret->addAnimation(_animation.release());
         }
@@ -137,7 +131,7 @@ public:
             _animation = std::move(ret);
     }
 
-    void visit(const ActionPawnRelocation & action) override
+    void operator()(const ActionPawnRelocation & action)
     {
         _animation = nullptr;
 
@@ -217,23 +211,20 @@ private:
     std::unique_ptr<QAbstractAnimation> _animation = nullptr;
 };
 
-class ActionMarkingVisitor final :
-        public Loki::BaseVisitor,
-        public Loki::Visitor<ActionComplex, void, true>,
-        public Loki::Visitor<ActionPawnRelocation, void, true>
+class ActionMarkingVisitor final
 {
 public:
     ActionMarkingVisitor(GameWidget * gameWidget)
         : _gameWidget{gameWidget}, _gameWidgetPrivate{GameWidgetPrivate::get(gameWidget)}
     { }
 
-    void visit(const ActionComplex & action) override
+    void operator()(const ActionComplex & action)
     {
         for(const auto & subAction : action.subActions())
-            subAction->accept(*this);
+            parchis::visit(*subAction, *this);
     }
 
-    void visit(const ActionPawnRelocation & action) override
+    void operator()(const ActionPawnRelocation & action)
     {
         std::unordered_map<PawnId, LocationId> pawnLocations;
 
@@ -713,7 +704,7 @@ void GameWidgetPrivate::addAnimation(const std::list<ConstActionUptr> & actions)
 
     for(const auto & action : actions)
     {
-        action->accept(actionAnimationVisitor);
+        parchis::visit(*action, actionAnimationVisitor);
 
         QAbstractAnimation * actionAnimation = actionAnimationVisitor.animation().release();
 
@@ -851,7 +842,7 @@ void GameWidgetPrivate::nestMousePress(QGraphicsSceneMouseEvent * event)
 
         if(resultCode.success())
         {
-            action->accept(bornPawnSearchVisitor);
+            parchis::visit(*action, bornPawnSearchVisitor);
             assert(bornPawnSearchVisitor.bornPawnIndex() != -1);
             actionFun(*action);
             movePawnActionsApply(game, bornPawnSearchVisitor.bornPawnIndex(), actionFun);
@@ -1314,6 +1305,13 @@ std::pair<CommandResultCode, ConstActionSptr> GameWidget::createCommandAction(Co
     return d->cachedCommands[command] = d->game.createCommandAction(command);
 }
 
+LegalCommands GameWidget::legalCommands() const
+{
+    Q_D(const GameWidget);
+
+    return d->game.legalCommands();
+}
+
 std::vector<std::pair<Command, ActionUptr>> GameWidget::availableCommands() const
 {
     Q_D(const GameWidget);
@@ -1534,7 +1532,7 @@ void GameWidget::showAction(const Action & action)
 
     ActionMarkingVisitor actionMarkingVisitor{this};
 
-    action.accept(actionMarkingVisitor);
+    parchis::visit(action, actionMarkingVisitor);
 }
 
 void GameWidget::showMovePawnAction(int pawnIndex)
@@ -1546,7 +1544,7 @@ void GameWidget::showMovePawnAction(int pawnIndex)
     auto [resultCode, action] = createCommandAction({Command::Kind::MovePawn, pawnIndex});
 
     if(resultCode.success())
-        action->accept(actionMarkingVisitor);
+        parchis::visit(*action, actionMarkingVisitor);
 }
 
 void GameWidget::showMovePawnActions(int pawnIndex)
@@ -1562,7 +1560,7 @@ void GameWidget::showMovePawnActions(int pawnIndex)
     movePawnActionsApply(d->game, pawnIndex, [d, &actionMarkingVisitor, &inverseActions]
                          (const Action & action)
     {
-        action.accept(actionMarkingVisitor);
+        parchis::visit(action, actionMarkingVisitor);
         inverseActions.emplace_front(d->game.takeAction(action));
     });
 
@@ -1579,7 +1577,7 @@ void GameWidget::showBirthAction()
     auto [resultCode, action] = createCommandAction({Command::Kind::Birth});
 
     if(resultCode.success())
-        action->accept(actionMarkingVisitor);
+        parchis::visit(*action, actionMarkingVisitor);
 }
 
 void GameWidget::showBirthActions()
@@ -1596,7 +1594,7 @@ void GameWidget::showBirthActions()
     auto actionFun = [d, &actionMarkingVisitor, &inverseActions]
             (const Action & action)
     {
-        action.accept(actionMarkingVisitor);
+        parchis::visit(action, actionMarkingVisitor);
         inverseActions.emplace_front(d->game.takeAction(action));
     };
 
@@ -1604,7 +1602,7 @@ void GameWidget::showBirthActions()
     {
         BornPawnSearchVisitor bornPawnSearchVisitor{this};
 
-        action->accept(bornPawnSearchVisitor);
+        parchis::visit(*action, bornPawnSearchVisitor);
         assert(bornPawnSearchVisitor.bornPawnIndex() != -1);
         actionFun(*action);
         movePawnActionsApply(d->game, bornPawnSearchVisitor.bornPawnIndex(), actionFun);
@@ -1623,7 +1621,7 @@ void GameWidget::showRansomAction(int captorPlayer)
     auto [resultCode, action] = createCommandAction({Command::Kind::Ransom, captorPlayer});
 
     if(resultCode.success())
-        action->accept(actionMarkingVisitor);
+        parchis::visit(*action, actionMarkingVisitor);
 }
 
 void GameWidget::hideActionMarking()
@@ -121,6 +121,7 @@ public:
     int diceUsed() const;
 
     std::pair<CommandResultCode, ConstActionSptr> createCommandAction(Command command) const;
+    LegalCommands legalCommands() const;
     std::vector<std::pair<Command, ActionUptr>> availableCommands() const;
 
     void startOver(std::vector<int> playerSideMap);
@@ -0,0 +1,55 @@
+#-------------------------------------------------
+#
+# Project created by QtCreator 2017-08-15T17:21:42
+#
+#-------------------------------------------------
+QMAKE_CXXFLAGS += -std=c++17
+QT       += core gui
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = Parchis
+TEMPLATE = app
+
+# The following define makes your compiler emit warnings if you use
+# any feature of Qt which as been marked as deprecated (the exact warnings
+# depend on your compiler). Please consult the documentation of the
+# deprecated API in order to know how to port your code away from it.
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# You can also make your code fail to compile if you use deprecated APIs.
+# In order to do so, uncomment the following line.
+# You can also select to disable deprecated APIs only up to a certain version of Qt.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+
+SOURCES += \
+        main.cpp \
+        mainwindow.cpp \
+    gamewidget.cpp \
+    gamewindow.cpp \
+    gamemanager.cpp
+
+HEADERS += \
+        mainwindow.h \
+    gamewidget.h \
+    gamewindow.h \
+    gamewidget_p.h \
+    gamemanager.h \
+    gamemanager_p.h
+
+FORMS += \
+        mainwindow.ui \
+    gamewindow.ui
+
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../core/release/ -lparchiscore
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../core/debug/ -lparchiscore
+else:unix: LIBS += -L$$OUT_PWD/../core/ -lparchiscore
+
+INCLUDEPATH += $$PWD/../core
+DEPENDPATH += $$PWD/../core
+
+win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/release/libparchiscore.a
+else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/debug/libparchiscore.a
+else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/release/parchiscore.lib
+else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/debug/parchiscore.lib
+else:unix: PRE_TARGETDEPS += $$OUT_PWD/../core/libparchiscore.a
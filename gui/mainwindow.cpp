@@ -55,13 +55,16 @@ void MainWindow::showGame()
     ui->lstwState->addItem(str);
 
     str = "playersFinishedMap: ";
-    for(bool finished : _game->playerSettings().playersFinishedMap())
-        str += QString::number(finished) + ", ";
+    for(int player = 0; player < _game->playerSettings().playerCount(); ++player)
+        str += QString::number(_game->playerSettings().isPlayerFinished(player)) + ", ";
     ui->lstwState->addItem(str);
 
-    str = "playersPlayingSet: ";
-    for(int player : _game->playerSettings().playersPlayingSet())
-        str += QString::number(player) + ", ";
+    str = "playersPlayingMap: ";
+    for(int player = 0; player < _game->playerSettings().playerCount(); ++player)
+    {
+        if(_game->playerSettings().playersPlayingMap().test(player))
+            str += QString::number(player) + ", ";
+    }
     ui->lstwState->addItem(str);
 
     str = "playerSideMap: ";
@@ -85,10 +88,8 @@ void MainWindow::showGame()
 
     i = 0;
 
-    for(const auto & [command, action] : _game->availableCommands())
+    for(parchis::Command command : _game->legalCommands())
     {
-        Q_UNUSED(action);
-
         ui->lstwCommand->addItem(QString("availableCommands[%1]: kind %2, param %3").arg(
                                     QString::number(i),
                                     commandKinds[static_cast<int>(command.kind)],
@@ -140,13 +141,12 @@ void MainWindow::showGame()
 
 void MainWindow::takeAction(int commandIndex)
 {
-    auto commands = _game->availableCommands();
+    auto commands = _game->legalCommands();
 
-    if(commandIndex < 0 || commandIndex >= commands.size())
+    if(commandIndex < 0 || commandIndex >= int(commands.size()))
         return;
 
-    parchis::ActionUptr action
-            = std::move(std::next(commands.begin(), commandIndex)->second);
+    parchis::ActionUptr action = _game->createCommandAction(commands[commandIndex]).second;
 
     emit actionTaken(*action);
     showGame();
@@ -154,29 +154,29 @@ void MainWindow::takeAction(int commandIndex)
 
 void MainWindow::showAction(int commandIndex)
 {
-    class ActionShowActionVisitor : public parchis::ActionFullVisitor
+    class ActionShowActionVisitor
     {
     public:
         ActionShowActionVisitor(Ui::MainWindow * ui) : _ui{ui} {}
 
-        void visit(const parchis::Action & /*action*/) override
+        void operator()(const parchis::Action & /*action*/)
         {
             _ui->lstwAction->addItem(")))");
         }
 
-        void visit(const parchis::ActionComplex & action) override
+        void operator()(const parchis::ActionComplex & action)
         {
             _ui->lstwAction->addItem(_indent + QString("complex: %1 subActions")
                                                .arg(action.subActions().size()));
             _ui->lstwAction->addItem(_indent + QString("{"));
             increaseIndent();
             for(const auto & subAction : action.subActions())
-                subAction->accept(*this);
+                parchis::visit(*subAction, *this);
             decreaseIndent();
             _ui->lstwAction->addItem(_indent + QString("}"));
         }
 
-        void visit(const parchis::ActionPawnTired & action) override
+        void operator()(const parchis::ActionPawnTired & action)
         {
             _ui->lstwAction->addItem(_indent + QString("pawnTired: %1 items")
                                                .arg(action.params().size()));
@@ -191,7 +191,7 @@ void MainWindow::showAction(int commandIndex)
             _ui->lstwAction->addItem(_indent + QString("}"));
         }
 
-        void visit(const parchis::ActionPawnRelocation & action) override
+        void operator()(const parchis::ActionPawnRelocation & action)
         {
             _ui->lstwAction->addItem(_indent + QString("pawnRelocation: %1 items")
                                                .arg(action.pawnRelocations().size()));
@@ -208,24 +208,26 @@ void MainWindow::showAction(int commandIndex)
             _ui->lstwAction->addItem(_indent + QString("}"));
         }
 
-        void visit(const parchis::ActionPlayerFinished & action) override
+        void operator()(const parchis::ActionPlayerFinished & action)
         {
             _ui->lstwAction->addItem(_indent + QString("playerFinished: %1").arg(action.player()));
         }
 
-        void visit(const parchis::ActionDiceUsed & action) override
+        void operator()(const parchis::ActionDiceUsed & action)
         {
             _ui->lstwAction->addItem(_indent + QString("diceUsed: %1").arg(action.diceUsed()));
         }
 
-        void visit(const parchis::ActionDice & action) override
+        void operator()(const parchis::ActionDice & action)
         {
-            _ui->lstwAction->addItem(_indent + QString("dice: %1, %2").arg(
-                                         QString::number(action.dice()[0]),
-                                         QString::number(action.dice()[1])));
+            QStringList dice;
+
+            for(int die : action.dice())
+                dice.append(QString::number(die));
+            _ui->lstwAction->addItem(_indent + QString("dice: %1").arg(dice.join(", ")));
         }
 
-        void visit(const parchis::ActionActionAndTurn & action) override
+        void operator()(const parchis::ActionActionAndTurn & action)
         {
             _ui->lstwAction->addItem(_indent + QString("actionAndTurn: %1, %2").arg(
                                          QString::number(action.playerTakingAction()),
@@ -246,16 +248,16 @@ void MainWindow::showAction(int commandIndex)
         QString _indent;
     } visitor{ui};
 
-    auto commands = _game->availableCommands();
+    auto commands = _game->legalCommands();
 
     ui->lstwAction->clear();
-    if(commandIndex < 0 || commandIndex >= commands.size())
+    if(commandIndex < 0 || commandIndex >= int(commands.size()))
         return;
 
-    parchis::ActionUptr action = std::move(std::next(commands.begin(), commandIndex)->second);
+    parchis::ActionUptr action = _game->createCommandAction(commands[commandIndex]).second;
 
     ui->lstwAction->clear();
-    action->accept(visitor);
+    parchis::visit(*action, visitor);
 
     emit actionShown(*action);
 }
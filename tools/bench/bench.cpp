@@ -0,0 +1,566 @@
+//Microbenchmarks of the hot paths of the engine and the AI on fixed, seeded positions. Prints a
+//table and writes a line per benchmark to compare versions.
+//
+//bench [--filter TEXT] [--min-time SECONDS] [--output FILE]
+//
+//Instructions are counted with perf events on Linux, the column is empty where they aren't
+//available.
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "aiengine.h"
+#include "aiengine_p.h"
+#include "game.h"
+#include "gamestate.h"
+
+using namespace parchis;
+
+//Every allocation of the program goes through these, so the count includes the heap actions
+static std::atomic<std::uint64_t> allocationCount{0};
+
+void * operator new(std::size_t size)
+{
+    ++allocationCount;
+    if(void * ret = std::malloc(size ? size : 1))
+        return ret;
+    throw std::bad_alloc{};
+}
+
+void * operator new(std::size_t size, std::align_val_t alignment)
+{
+    std::size_t align = static_cast<std::size_t>(alignment);
+
+    ++allocationCount;
+    if(void * ret = std::aligned_alloc(align, (size + align - 1) / align * align))
+        return ret;
+    throw std::bad_alloc{};
+}
+
+void * operator new[](std::size_t size) { return operator new(size); }
+void * operator new[](std::size_t size, std::align_val_t alignment)
+    { return operator new(size, alignment); }
+void operator delete(void * pointer) noexcept { std::free(pointer); }
+void operator delete(void * pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void * pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void * pointer, std::size_t, std::align_val_t) noexcept
+    { std::free(pointer); }
+void operator delete[](void * pointer) noexcept { std::free(pointer); }
+void operator delete[](void * pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void * pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void * pointer, std::size_t, std::align_val_t) noexcept
+    { std::free(pointer); }
+
+//Instructions retired in user space by this thread, if the kernel lets us count them
+class InstructionCounter
+{
+public:
+    InstructionCounter()
+    {
+#ifdef __linux__
+        perf_event_attr attr{};
+
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~InstructionCounter()
+    {
+#ifdef __linux__
+        if(_fd != -1)
+            close(_fd);
+#endif
+    }
+
+    InstructionCounter(const InstructionCounter &) = delete;
+    InstructionCounter & operator=(const InstructionCounter &) = delete;
+
+    bool isAvailable() const { return _fd != -1; }
+
+    std::uint64_t read() const
+    {
+        std::uint64_t ret = 0;
+
+#ifdef __linux__
+        if(_fd == -1 || ::read(_fd, &ret, sizeof(ret)) != sizeof(ret))
+            return 0;
+#endif
+        return ret;
+    }
+
+private:
+    int _fd = -1;
+};
+
+struct Settings
+{
+    std::string filter;
+    double minSeconds = 0.2;
+    std::string outputFileName = "bench.csv";
+};
+
+struct Measurement
+{
+    double nsPerOp = 0;
+    double allocationsPerOp = 0;
+    double instructionsPerOp = NAN;
+};
+
+//A position with a command legal in it, drawn from seeded random games
+struct Sample
+{
+    Game game;
+    Command command;
+};
+
+static bool parseSettings(int argc, char * argv[], Settings & settings)
+{
+    for(int index = 1; index < argc; ++index)
+    {
+        std::string option = argv[index];
+
+        if(index + 1 >= argc)
+            return false;
+
+        std::string value = argv[++index];
+
+        if(option == "--filter")
+            settings.filter = value;
+        else if(option == "--min-time")
+            settings.minSeconds = std::atof(value.c_str());
+        else if(option == "--output")
+            settings.outputFileName = value;
+        else
+            return false;
+    }
+
+    return true;
+}
+
+//Plays seeded random four player games and keeps up to sampleCount positions of each command
+//kind, spaced out so they come from all stages of the games
+static std::vector<Sample> collectSamples(Command::Kind kind, std::size_t sampleCount)
+{
+    const int stride = 7;
+    std::vector<Sample> ret;
+
+    for(std::uint64_t seed = 1; seed <= 64 && ret.size() < sampleCount; ++seed)
+    {
+        Game game{CounterDiceGenerator<dieSideCount, dieCount>{seed, 0}};
+        std::uint64_t choiceState = seed;
+        int sinceLastSample = stride;
+
+        game.startOver({0, 1, 2, 3});
+        while(!game.isFinished() && ret.size() < sampleCount)
+        {
+            LegalCommands commands = game.legalCommands();
+
+            for(Command command : commands)
+            {
+                if(command.kind == kind && ++sinceLastSample >= stride)
+                {
+                    ret.push_back({game, command});
+                    sinceLastSample = 0;
+                    break;
+                }
+            }
+
+            CompactAction action;
+
+            game.createCommandAction(commands[splitMix64(choiceState) % commands.size()], action);
+            game.takeAction(action);
+        }
+    }
+
+    return ret;
+}
+
+//Positions where the player acting moves pawns, the usual input of the AI
+static std::vector<Game> movePositions()
+{
+    std::vector<Game> ret;
+
+    for(Sample & sample : collectSamples(Command::Kind::MovePawn, 16))
+        ret.push_back(std::move(sample.game));
+    return ret;
+}
+
+//Calls the function, which does opsPerCall operations, in doubling batches until a batch takes
+//minSeconds, and reports the last batch
+static Measurement measure(const std::function<void()> & function, std::size_t opsPerCall,
+                           double minSeconds, const InstructionCounter & instructionCounter)
+{
+    Measurement ret;
+
+    function();
+    for(std::size_t callCount = 1; ; callCount *= 2)
+    {
+        std::uint64_t allocationsBefore = allocationCount;
+        std::uint64_t instructionsBefore = instructionCounter.read();
+        auto startTime = std::chrono::steady_clock::now();
+
+        for(std::size_t call = 0; call < callCount; ++call)
+            function();
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                       startTime).count();
+        std::uint64_t instructions = instructionCounter.read() - instructionsBefore;
+        double opCount = double(callCount) * opsPerCall;
+
+        if(seconds >= minSeconds)
+        {
+            ret.nsPerOp = seconds * 1e9 / opCount;
+            ret.allocationsPerOp = (allocationCount - allocationsBefore) / opCount;
+            if(instructionCounter.isAvailable())
+                ret.instructionsPerOp = instructions / opCount;
+            return ret;
+        }
+    }
+}
+
+//Keeps the optimizer from dropping the results
+static volatile std::uint64_t sink;
+
+class Benchmarks
+{
+public:
+    Benchmarks(const Settings & settings, std::ofstream & output)
+        : _settings{settings}, _output{output} {}
+
+    //Searches also report the nodes they visit per op, which don't depend on the machine
+    void run(const std::string & name, std::size_t opsPerCall,
+             const std::function<void()> & function, double nodesPerOp = NAN)
+    {
+        if(name.find(_settings.filter) == std::string::npos || opsPerCall == 0)
+            return;
+
+        Measurement measurement = measure(function, opsPerCall, _settings.minSeconds,
+                                          _instructionCounter);
+
+        std::printf("%-32s %12.1f ns/op %8.2f allocs/op", name.c_str(), measurement.nsPerOp,
+                    measurement.allocationsPerOp);
+        _output << name << ',' << measurement.nsPerOp << ',' << measurement.allocationsPerOp
+                << ',';
+        if(!std::isnan(measurement.instructionsPerOp))
+        {
+            std::printf(" %12.0f instr/op", measurement.instructionsPerOp);
+            _output << measurement.instructionsPerOp;
+        }
+        _output << ',';
+        if(!std::isnan(nodesPerOp))
+        {
+            std::printf(" %10.0f nodes/op", nodesPerOp);
+            _output << nodesPerOp;
+        }
+        std::printf("\n");
+        _output << '\n';
+    }
+
+private:
+    const Settings & _settings;
+    std::ofstream & _output;
+    InstructionCounter _instructionCounter;
+};
+
+static const char * commandKindName(Command::Kind kind)
+{
+    switch(kind)
+    {
+    case Command::Kind::Skip:
+        return "Skip";
+    case Command::Kind::RollDice:
+        return "RollDice";
+    case Command::Kind::MovePawn:
+        return "MovePawn";
+    case Command::Kind::Birth:
+        return "Birth";
+    case Command::Kind::Ransom:
+        return "Ransom";
+    }
+    return "";
+}
+
+static void runGameBenchmarks(Benchmarks & benchmarks, std::vector<Game> & positions)
+{
+    benchmarks.run("Game::legalCommands", positions.size(), [&]
+    {
+        for(const Game & game : positions)
+            sink = sink + game.legalCommands().size();
+    });
+
+    benchmarks.run("Game::availableCommands", positions.size(), [&]
+    {
+        for(const Game & game : positions)
+            sink = sink + game.availableCommands().size();
+    });
+
+    for(Command::Kind kind : {Command::Kind::Skip, Command::Kind::RollDice,
+                              Command::Kind::MovePawn, Command::Kind::Birth,
+                              Command::Kind::Ransom})
+    {
+        std::vector<Sample> samples = collectSamples(kind, 16);
+        std::string name = std::string{"create"} + commandKindName(kind) + "Action";
+
+        benchmarks.run(name, samples.size(), [&]
+        {
+            for(const Sample & sample : samples)
+                sink = sink + bool(sample.game.createCommandAction(sample.command).second);
+        });
+
+        benchmarks.run(name + "/compact", samples.size(), [&]
+        {
+            for(const Sample & sample : samples)
+            {
+                CompactAction action;
+
+                sample.game.createCommandAction(sample.command, action);
+                sink = sink + action.pawnRelocations.size();
+            }
+        });
+    }
+
+    //Actions of every kind of command, taken and undone in the positions they were built in
+    std::vector<Game> actionGames;
+    std::vector<ActionUptr> actions;
+    std::vector<CompactAction> compactActions;
+
+    for(Command::Kind kind : {Command::Kind::Skip, Command::Kind::MovePawn,
+                              Command::Kind::Birth, Command::Kind::Ransom})
+    {
+        for(Sample & sample : collectSamples(kind, 8))
+        {
+            actions.push_back(sample.game.createCommandAction(sample.command).second);
+            sample.game.createCommandAction(sample.command, compactActions.emplace_back());
+            actionGames.push_back(std::move(sample.game));
+        }
+    }
+
+    benchmarks.run("Game::takeAction+inverse", actions.size(), [&]
+    {
+        for(std::size_t index = 0; index < actions.size(); ++index)
+        {
+            ActionUptr inverse = actionGames[index].takeAction(*actions[index]);
+
+            actionGames[index].takeAction(*inverse);
+        }
+    });
+
+    benchmarks.run("Game::doAction+undo", compactActions.size(), [&]
+    {
+        for(std::size_t index = 0; index < compactActions.size(); ++index)
+        {
+            UndoRecord record;
+
+            actionGames[index].doAction(compactActions[index], record);
+            actionGames[index].undo(record);
+        }
+    });
+
+    //Commands build complex actions of their subactions
+    std::vector<GameState> gameStates;
+    std::vector<const Action *> complexActions;
+
+    for(std::size_t index = 0; index < actions.size(); ++index)
+    {
+        if(actions[index]->kind() == ActionKind::Complex)
+        {
+            gameStates.push_back(actionGames[index].packedState().unpack());
+            complexActions.push_back(actions[index].get());
+        }
+    }
+
+    benchmarks.run("ActionComplex::commit+inverse", complexActions.size(), [&]
+    {
+        for(std::size_t index = 0; index < complexActions.size(); ++index)
+            complexActions[index]->commit(gameStates[index])->commit(gameStates[index]);
+    });
+}
+
+static void runBoardBenchmarks(Benchmarks & benchmarks, const std::vector<Game> & positions)
+{
+    //Moves a pawn to where another pawn is and back
+    std::vector<Board> boards;
+    std::vector<std::pair<PawnId, LocationId>> relocations;
+
+    for(const Game & game : positions)
+    {
+        const Board & board = game.board();
+        auto pawns = board.pawns();
+
+        for(auto first = pawns.begin(); first != pawns.end(); ++first)
+        {
+            auto second = first;
+
+            if(++second == pawns.end())
+                break;
+            if((*first).second.locationId != (*second).second.locationId)
+            {
+                boards.push_back(board);
+                relocations.emplace_back((*first).first, (*second).second.locationId);
+                break;
+            }
+        }
+    }
+
+    benchmarks.run("Board::relocatePawn", relocations.size() * 2, [&]
+    {
+        for(std::size_t index = 0; index < relocations.size(); ++index)
+        {
+            auto [pawnId, locationId] = relocations[index];
+            LocationId sourceLocationId = boards[index].pawn(pawnId).locationId;
+
+            boards[index].relocatePawn(pawnId, locationId);
+            boards[index].relocatePawn(pawnId, sourceLocationId);
+        }
+    });
+
+    std::size_t locationCount = 0;
+
+    for(const Game & game : positions)
+        locationCount += game.board().locations().size();
+
+    benchmarks.run("Location::pawnCount", locationCount, [&]
+    {
+        for(const Game & game : positions)
+        {
+            int player = game.playerActing();
+
+            for(const auto & [locationId, location] : game.board().locations())
+                sink = sink + location.pawnCount(player);
+        }
+    });
+}
+
+static void runAiBenchmarks(Benchmarks & benchmarks, std::vector<Game> & positions)
+{
+    benchmarks.run("evaluatePosition", positions.size(), [&]
+    {
+        for(const Game & game : positions)
+            sink = sink + std::uint64_t(playerScore(evaluatePosition(game), game.playerActing()));
+    });
+
+    //Every pawn on the main track of the player acting, to every square up to the farthest roll
+    const int maxDistance = dieCount * dieSideCount;
+    std::vector<std::pair<const Game *, int>> pawnRelSquares;
+
+    for(const Game & game : positions)
+    {
+        int player = game.playerActing();
+        int side = game.playerSettings().playerSideMap().at(player);
+
+        for(const auto & [pawnId, pawn] : game.board().pawns())
+        {
+            if(pawnId.player == player && pawn.locationId.section.kind == Section::Kind::Main)
+                pawnRelSquares.emplace_back(&game, Game::mainSquareToRelSquare(
+                                                pawn.locationId.square, side));
+        }
+    }
+
+    benchmarks.run("distanceChance", pawnRelSquares.size() * maxDistance, [&]
+    {
+        double sum = 0;
+
+        for(const auto & [game, relSquare] : pawnRelSquares)
+        {
+            for(int distance = 1; distance <= maxDistance; ++distance)
+                sum += distanceChance(*game, game->playerActing(), relSquare, distance, {});
+        }
+        sink = sink + std::uint64_t(sum);
+    });
+
+    benchmarks.run("buildCommandTree", positions.size(), [&]
+    {
+        for(Game & game : positions)
+            sink = sink + buildCommandTree(game)->children.size();
+    });
+
+    benchmarks.run("chooseCommandSequence", positions.size(), [&]
+    {
+        for(Game & game : positions)
+            sink = sink + chooseCommandSequence(game).size();
+    });
+
+    //The search with and without pruning the dice outcomes
+    const std::pair<ChancePruning, const char *> chancePrunings[] = {
+        {ChancePruning::None, "none"},
+        {ChancePruning::Star1, "star1"},
+        {ChancePruning::Star2, "star2"}
+    };
+
+    for(int depth = 1; depth <= 2; ++depth)
+    {
+        for(auto [chancePruning, pruningName] : chancePrunings)
+        {
+            SearchSettings searchSettings;
+            long nodeCount = 0;
+
+            searchSettings.depth = depth;
+            searchSettings.chancePruning = chancePruning;
+            for(Game & game : positions)
+            {
+                SearchStats stats;
+
+                chooseCommandSequence(game, searchSettings, stats);
+                nodeCount += stats.decisionNodeCount + stats.chanceNodeCount +
+                        stats.evaluationCount;
+            }
+
+            benchmarks.run("search/depth" + std::to_string(depth) + "/" + pruningName,
+                           positions.size(), [&]
+            {
+                for(Game & game : positions)
+                    sink = sink + chooseCommandSequence(game, searchSettings).size();
+            }, double(nodeCount) / positions.size());
+        }
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    Settings settings;
+
+    if(!parseSettings(argc, argv, settings))
+    {
+        std::fprintf(stderr, "Usage: bench [--filter TEXT] [--min-time SECONDS] "
+                             "[--output FILE]\n");
+        return 1;
+    }
+
+    std::ofstream output{settings.outputFileName};
+
+    if(!output)
+    {
+        std::fprintf(stderr, "Cannot open %s\n", settings.outputFileName.c_str());
+        return 1;
+    }
+    output << "benchmark,ns_per_op,allocations_per_op,instructions_per_op,nodes_per_op\n";
+
+    Benchmarks benchmarks{settings, output};
+    std::vector<Game> positions = movePositions();
+
+    runGameBenchmarks(benchmarks, positions);
+    runBoardBenchmarks(benchmarks, positions);
+    runAiBenchmarks(benchmarks, positions);
+    return 0;
+}
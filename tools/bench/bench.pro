@@ -0,0 +1,31 @@
+#-------------------------------------------------
+#
+# Microbenchmarks of the engine hot paths, see bench.cpp
+#
+#-------------------------------------------------
+QMAKE_CXXFLAGS += -std=c++17
+QT -= core gui
+CONFIG -= qt app_bundle
+CONFIG += console thread optimize_full
+
+TARGET = bench
+TEMPLATE = app
+
+CONFIG(release, debug|release): DEFINES += NDEBUG
+
+
+SOURCES += \
+    bench.cpp
+
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../../core/release/ -lparchiscore
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../../core/debug/ -lparchiscore
+else:unix: LIBS += -L$$OUT_PWD/../../core/ -lparchiscore
+
+INCLUDEPATH += $$PWD/../../core
+DEPENDPATH += $$PWD/../../core
+
+win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../../core/release/libparchiscore.a
+else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../../core/debug/libparchiscore.a
+else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../../core/release/parchiscore.lib
+else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../../core/debug/parchiscore.lib
+else:unix: PRE_TARGETDEPS += $$OUT_PWD/../../core/libparchiscore.a
@@ -0,0 +1,319 @@
+//Perft: counts the positions reachable to a given depth to check and time move generation.
+//Every command is one ply and a roll expands into every distinct dice outcome, so the counts
+//are of the chance tree, not weighted by probability. Finished games are leaves that do not
+//count at all.
+//
+//perft [--position NAME] [--depth N] [--threads N] [--reference]
+//
+//Every canonical position is searched at its depth and checked against its known count, or only
+//the named one. --reference also runs the Action based path and checks both paths agree.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "game.h"
+
+using namespace parchis;
+
+struct Settings
+{
+    std::string positionName;
+    int depth = -1;
+    unsigned int threadCount = std::thread::hardware_concurrency();
+    bool reference = false;
+};
+
+//A position is set up by playing commands picked at random from a new game, the dice and the
+//picks both drawn from the seed. knownCount is the count at depth.
+struct CanonicalPosition
+{
+    const char * name;
+    std::vector<int> playerSideMap;
+    std::uint64_t seed;
+    int setupCommandCount;
+    int depth;
+    std::uint64_t knownCount;
+};
+
+static const std::vector<CanonicalPosition> canonicalPositions = {
+    {"start2", {0, 2}, 0, 0, 13, 5689075},
+    {"start4", {0, 1, 2, 3}, 0, 0, 13, 4654272},
+    {"early4", {0, 1, 2, 3}, 1, 40, 14, 527816},
+    {"middle4", {0, 1, 2, 3}, 2, 200, 13, 10115659},
+    {"middle3", {0, 1, 2}, 3, 300, 13, 7575303},
+    {"late2", {0, 2}, 4, 250, 12, 3381738}
+};
+
+static constexpr auto rollOutcomes = diceOutcomes<dieSideCount, dieCount>;
+
+static bool parseSettings(int argc, char * argv[], Settings & settings)
+{
+    for(int index = 1; index < argc; ++index)
+    {
+        std::string option = argv[index];
+
+        if(option == "--reference")
+        {
+            settings.reference = true;
+            continue;
+        }
+
+        if(index + 1 >= argc)
+            return false;
+
+        std::string value = argv[++index];
+
+        if(option == "--position")
+            settings.positionName = value;
+        else if(option == "--depth")
+            settings.depth = std::atoi(value.c_str());
+        else if(option == "--threads")
+            settings.threadCount = static_cast<unsigned int>(std::atoi(value.c_str()));
+        else
+            return false;
+    }
+
+    return true;
+}
+
+static Game setUpPosition(const CanonicalPosition & position)
+{
+    Game ret{CounterDiceGenerator<dieSideCount, dieCount>{position.seed, 0}};
+    std::uint64_t choiceState = position.seed;
+
+    ret.startOver(position.playerSideMap);
+    for(int index = 0; index < position.setupCommandCount && !ret.isFinished(); ++index)
+    {
+        LegalCommands commands = ret.legalCommands();
+        CompactAction action;
+
+        ret.createCommandAction(commands[splitMix64(choiceState) % commands.size()], action);
+        ret.takeAction(action);
+    }
+
+    return ret;
+}
+
+//Reference path: heap actions from availableCommands, taken and taken back through their inverse
+static std::uint64_t referencePerft(Game & game, int depth)
+{
+    if(depth == 0)
+        return 1;
+
+    std::uint64_t ret = 0;
+
+    auto takeAndCount = [&](const Action & action)
+    {
+        ActionUptr inverse = game.takeAction(action);
+
+        ret += referencePerft(game, depth - 1);
+        game.takeAction(*inverse);
+    };
+
+    for(const auto & [command, action] : game.availableCommands())
+    {
+        if(command.kind == Command::Kind::RollDice)
+        {
+            for(const auto & outcome : rollOutcomes)
+                takeAndCount(*game.createRollDiceAction(outcome.dice).second);
+        }
+        else
+            takeAndCount(*action);
+    }
+
+    return ret;
+}
+
+//The children of the position, every dice outcome standing for RollDice
+static std::vector<CompactAction> children(const Game & game)
+{
+    std::vector<CompactAction> ret;
+
+    for(Command command : game.legalCommands())
+    {
+        if(command.kind == Command::Kind::RollDice)
+        {
+            for(const auto & outcome : rollOutcomes)
+                game.createRollDiceAction(outcome.dice, ret.emplace_back());
+        }
+        else
+            game.createCommandAction(command, ret.emplace_back());
+    }
+
+    return ret;
+}
+
+//Fast path: legalCommands, compact actions and make/unmake. The last ply is counted without
+//building its actions.
+static std::uint64_t fastPerft(Game & game, int depth)
+{
+    if(depth == 0)
+        return 1;
+
+    LegalCommands commands = game.legalCommands();
+    std::uint64_t ret = 0;
+
+    if(depth == 1)
+    {
+        for(Command command : commands)
+            ret += command.kind == Command::Kind::RollDice ? rollOutcomes.size() : 1;
+        return ret;
+    }
+
+    auto doAndCount = [&](const CompactAction & action)
+    {
+        UndoRecord record;
+
+        game.doAction(action, record);
+        ret += fastPerft(game, depth - 1);
+        game.undo(record);
+    };
+
+    for(Command command : commands)
+    {
+        if(command.kind == Command::Kind::RollDice)
+        {
+            for(const auto & outcome : rollOutcomes)
+            {
+                CompactAction action;
+
+                game.createRollDiceAction(outcome.dice, action);
+                doAndCount(action);
+            }
+        }
+        else
+        {
+            CompactAction action;
+
+            game.createCommandAction(command, action);
+            doAndCount(action);
+        }
+    }
+
+    return ret;
+}
+
+//Splits the root children between threads, each searching its own copy of the game
+static std::uint64_t parallelPerft(const Game & game, int depth, unsigned int threadCount)
+{
+    if(depth < 2 || threadCount < 2)
+    {
+        Game copy = game;
+
+        return fastPerft(copy, depth);
+    }
+
+    std::vector<CompactAction> rootChildren = children(game);
+    std::atomic<std::size_t> nextChild{0};
+    std::atomic<std::uint64_t> ret{0};
+    std::vector<std::thread> threads;
+
+    auto work = [&]
+    {
+        Game copy = game;
+        std::uint64_t count = 0;
+
+        for(std::size_t index = nextChild++; index < rootChildren.size(); index = nextChild++)
+        {
+            UndoRecord record;
+
+            copy.doAction(rootChildren[index], record);
+            count += fastPerft(copy, depth - 1);
+            copy.undo(record);
+        }
+        ret += count;
+    };
+
+    for(unsigned int thread = 1; thread < threadCount; ++thread)
+        threads.emplace_back(work);
+    work();
+    for(auto & thread : threads)
+        thread.join();
+
+    return ret;
+}
+
+template<class Function>
+static std::uint64_t timed(Function function, double & seconds)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    std::uint64_t ret = function();
+
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return ret;
+}
+
+int main(int argc, char * argv[])
+{
+    Settings settings;
+
+    if(!parseSettings(argc, argv, settings))
+    {
+        std::fprintf(stderr, "Usage: perft [--position NAME] [--depth N] [--threads N] "
+                             "[--reference]\n");
+        return 1;
+    }
+
+    bool found = false;
+    bool ok = true;
+    std::uint64_t totalCount = 0;
+    double totalSeconds = 0;
+
+    if(settings.threadCount == 0)
+        settings.threadCount = 1;
+
+    for(const auto & position : canonicalPositions)
+    {
+        if(!settings.positionName.empty() && settings.positionName != position.name)
+            continue;
+        found = true;
+
+        int depth = settings.depth >= 0 ? settings.depth : position.depth;
+        Game game = setUpPosition(position);
+        double seconds;
+        std::uint64_t count = timed([&]{ return parallelPerft(game, depth, settings.threadCount); },
+                                    seconds);
+
+        std::printf("%-8s depth %d: %llu nodes in %.3f s, %.0f nodes/s", position.name, depth,
+                    static_cast<unsigned long long>(count), seconds, count / seconds);
+        if(depth == position.depth)
+        {
+            bool known = count == position.knownCount;
+
+            std::printf(known ? ", known count" : ", known count is %llu",
+                        static_cast<unsigned long long>(position.knownCount));
+            ok = ok && known;
+        }
+        std::printf("\n");
+        totalCount += count;
+        totalSeconds += seconds;
+
+        if(settings.reference)
+        {
+            std::uint64_t referenceCount = timed([&]{ return referencePerft(game, depth); },
+                                                 seconds);
+
+            std::printf("%-8s reference: %llu nodes in %.3f s, %.0f nodes/s%s\n", position.name,
+                        static_cast<unsigned long long>(referenceCount), seconds,
+                        referenceCount / seconds, referenceCount == count ? "" : ", MISMATCH");
+            ok = ok && referenceCount == count;
+        }
+    }
+
+    if(!found)
+    {
+        std::fprintf(stderr, "Unknown position %s\n", settings.positionName.c_str());
+        return 1;
+    }
+
+    std::printf("total: %llu nodes in %.3f s on %u threads, %.0f nodes/s\n",
+                static_cast<unsigned long long>(totalCount), totalSeconds, settings.threadCount,
+                totalCount / totalSeconds);
+    return ok ? 0 : 2;
+}
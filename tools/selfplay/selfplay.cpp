@@ -0,0 +1,277 @@
+//Headless self-play: plays games between agents on all cores and writes a line per game.
+//
+//selfplay [--games N] [--seats N] [--agents ai,random,...] [--seed N] [--threads N]
+//         [--depth N] [--time-budget MS] [--output FILE]
+//
+//An ai agent searches with --depth and --time-budget, aiN searches to depth N instead, so
+//agents of different depths can play each other.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "aiengine.h"
+#include "game.h"
+#include "workstealingpool.h"
+
+using namespace parchis;
+
+struct Agent
+{
+    enum class Kind
+    {
+        Ai,
+        Random,
+        FirstLegal
+    };
+
+    Kind kind;
+    //Search depth of an Ai agent, -1 to use the one of the settings
+    int depth = -1;
+};
+
+struct Settings
+{
+    std::size_t gameCount = 1000;
+    std::vector<Agent> agents = {{Agent::Kind::Ai}, {Agent::Kind::Random},
+                                 {Agent::Kind::Random}, {Agent::Kind::Random}};
+    SearchSettings searchSettings;
+    std::uint64_t seed = 0;
+    unsigned int threadCount = std::thread::hardware_concurrency();
+    std::string outputFileName = "selfplay.csv";
+};
+
+struct GameResult
+{
+    std::vector<int> playersFinished;
+    long turnCount = 0;
+    long actionCount = 0;
+    double seconds = 0;
+};
+
+static bool parseAgents(const std::string & text, std::vector<Agent> & agents)
+{
+    std::istringstream stream{text};
+    std::string name;
+
+    agents.clear();
+    while(std::getline(stream, name, ','))
+    {
+        if(name == "ai")
+            agents.push_back({Agent::Kind::Ai});
+        else if(name.size() > 2 && name.compare(0, 2, "ai") == 0 &&
+                name.find_first_not_of("0123456789", 2) == std::string::npos)
+            agents.push_back({Agent::Kind::Ai, std::atoi(name.c_str() + 2)});
+        else if(name == "random")
+            agents.push_back({Agent::Kind::Random});
+        else if(name == "first")
+            agents.push_back({Agent::Kind::FirstLegal});
+        else
+            return false;
+    }
+
+    return true;
+}
+
+static bool parseSettings(int argc, char * argv[], Settings & settings)
+{
+    int seatCount = -1;
+
+    for(int index = 1; index < argc; ++index)
+    {
+        std::string option = argv[index];
+
+        if(index + 1 >= argc)
+            return false;
+
+        std::string value = argv[++index];
+
+        if(option == "--games")
+            settings.gameCount = std::strtoull(value.c_str(), nullptr, 10);
+        else if(option == "--seats")
+        {
+            seatCount = std::atoi(value.c_str());
+            if(seatCount < 2 || seatCount > sideCount)
+                return false;
+        }
+        else if(option == "--agents")
+        {
+            if(!parseAgents(value, settings.agents))
+                return false;
+        }
+        else if(option == "--seed")
+            settings.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if(option == "--threads")
+            settings.threadCount = static_cast<unsigned int>(std::atoi(value.c_str()));
+        else if(option == "--depth")
+            settings.searchSettings.depth = std::atoi(value.c_str());
+        else if(option == "--time-budget")
+        {
+            settings.searchSettings.timeBudget =
+                    std::chrono::milliseconds{std::atol(value.c_str())};
+        }
+        else if(option == "--output")
+            settings.outputFileName = value;
+        else
+            return false;
+    }
+
+    //Without --seats the agent list gives the seat count, with it the list is cut or its last
+    //agent repeated
+    if(seatCount != -1)
+    {
+        if(settings.agents.empty())
+            return false;
+        settings.agents.resize(seatCount, settings.agents.back());
+    }
+
+    return settings.agents.size() >= 2 && settings.agents.size() <= std::size_t(sideCount);
+}
+
+//Seats are spread around the board, so two players sit on opposite sides
+static std::vector<int> seatSides(int seatCount)
+{
+    std::vector<int> ret;
+
+    for(int seat = 0; seat < seatCount; ++seat)
+        ret.push_back(seat * sideCount / seatCount);
+    return ret;
+}
+
+static void takeCommand(Game & game, Command command, GameResult & result)
+{
+    CompactAction action;
+
+    game.createCommandAction(command, action);
+    game.takeAction(action);
+    ++result.actionCount;
+    if(command.kind == Command::Kind::RollDice)
+        ++result.turnCount;
+}
+
+static GameResult playGame(const Settings & settings, std::size_t gameIndex)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    GameResult ret;
+    Game game{CounterDiceGenerator<dieSideCount, dieCount>{settings.seed, gameIndex}};
+    std::uint64_t choiceState = settings.seed ^ (gameIndex << 1 | 1);
+
+    game.startOver(seatSides(int(settings.agents.size())));
+
+    while(!game.isFinished())
+    {
+        LegalCommands commands = game.legalCommands();
+        int player = game.playerActing();
+
+        if(commands.size() == 1)
+        {
+            takeCommand(game, commands[0], ret);
+            continue;
+        }
+
+        const Agent & agent = settings.agents[player];
+
+        switch(agent.kind)
+        {
+        case Agent::Kind::Ai:
+        {
+            SearchSettings searchSettings = settings.searchSettings;
+
+            if(agent.depth != -1)
+                searchSettings.depth = agent.depth;
+
+            auto commandSequence = chooseCommandSequence(game, searchSettings);
+
+            if(commandSequence.empty())
+            {
+                takeCommand(game, commands[0], ret);
+                break;
+            }
+
+            for(const auto & [command, action] : commandSequence)
+            {
+                if(game.isFinished() || game.playerActing() != player)
+                    break;
+                game.takeAction(*action);
+                ++ret.actionCount;
+            }
+            break;
+        }
+        case Agent::Kind::Random:
+            takeCommand(game, commands[splitMix64(choiceState) % commands.size()], ret);
+            break;
+        case Agent::Kind::FirstLegal:
+            takeCommand(game, commands[0], ret);
+            break;
+        }
+    }
+
+    ret.playersFinished = game.playerSettings().playersFinishedList();
+    ret.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                startTime).count();
+    return ret;
+}
+
+int main(int argc, char * argv[])
+{
+    Settings settings;
+
+    if(!parseSettings(argc, argv, settings))
+    {
+        std::fprintf(stderr, "Usage: selfplay [--games N] [--seats 2-%d] "
+                             "[--agents ai|aiN|random|first,...] [--seed N] [--threads N] "
+                             "[--depth N] [--time-budget MS] [--output FILE]\n", sideCount);
+        return 1;
+    }
+
+    std::ofstream output{settings.outputFileName};
+
+    if(!output)
+    {
+        std::fprintf(stderr, "Cannot open %s\n", settings.outputFileName.c_str());
+        return 1;
+    }
+    output << "game,finish_order,turns,actions,seconds\n";
+
+    WorkStealingPool pool{settings.threadCount};
+    std::mutex outputMutex;
+    std::vector<long> firstPlaces(settings.agents.size());
+    long actionCount = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    pool.run(settings.gameCount, [&](unsigned int /*worker*/, std::size_t gameIndex)
+    {
+        GameResult result = playGame(settings, gameIndex);
+        std::ostringstream line;
+
+        line << gameIndex << ',';
+        for(std::size_t place = 0; place < result.playersFinished.size(); ++place)
+            line << (place ? " " : "") << result.playersFinished[place];
+        line << ',' << result.turnCount << ',' << result.actionCount << ',' << result.seconds
+             << '\n';
+
+        std::lock_guard<std::mutex> lock{outputMutex};
+
+        output << line.str();
+        if(!result.playersFinished.empty())
+            ++firstPlaces[result.playersFinished.front()];
+        actionCount += result.actionCount;
+    });
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                   startTime).count();
+
+    std::printf("%zu games, %ld actions in %.2f s on %u threads: %.1f games/s, %.0f actions/s\n",
+                settings.gameCount, actionCount, seconds, pool.threadCount(),
+                settings.gameCount / seconds, actionCount / seconds);
+    for(std::size_t seat = 0; seat < firstPlaces.size(); ++seat)
+        std::printf("seat %zu: first in %ld games\n", seat, firstPlaces[seat]);
+    return 0;
+}
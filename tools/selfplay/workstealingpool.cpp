@@ -0,0 +1,73 @@
+#include "workstealingpool.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+WorkStealingPool::WorkStealingPool(unsigned int threadCount)
+    : _threadCount{std::max(threadCount, 1u)}, _queues{new Queue[_threadCount]}
+{ }
+
+void WorkStealingPool::run(std::size_t taskCount, const Task & task)
+{
+    for(unsigned int worker = 0; worker < _threadCount; ++worker)
+    {
+        std::size_t first = taskCount * worker / _threadCount;
+        std::size_t last = taskCount * (worker + 1) / _threadCount;
+
+        _queues[worker].taskIndices.clear();
+        for(std::size_t taskIndex = first; taskIndex < last; ++taskIndex)
+            _queues[worker].taskIndices.push_back(taskIndex);
+    }
+
+    std::vector<std::thread> threads;
+
+    //The calling thread is worker 0
+    for(unsigned int worker = 1; worker < _threadCount; ++worker)
+        threads.emplace_back(&WorkStealingPool::work, this, worker, std::cref(task));
+    work(0, task);
+
+    for(std::thread & thread : threads)
+        thread.join();
+}
+
+bool WorkStealingPool::popOwn(unsigned int worker, std::size_t & taskIndex)
+{
+    Queue & queue = _queues[worker];
+    std::lock_guard<std::mutex> lock{queue.mutex};
+
+    if(queue.taskIndices.empty())
+        return false;
+
+    taskIndex = queue.taskIndices.back();
+    queue.taskIndices.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned int worker, std::size_t & taskIndex)
+{
+    //Tasks are never added during a run, so one pass over the others that finds nothing means
+    //there is nothing left to steal
+    for(unsigned int offset = 1; offset < _threadCount; ++offset)
+    {
+        Queue & queue = _queues[(worker + offset) % _threadCount];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+
+        if(!queue.taskIndices.empty())
+        {
+            taskIndex = queue.taskIndices.front();
+            queue.taskIndices.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingPool::work(unsigned int worker, const Task & task)
+{
+    std::size_t taskIndex;
+
+    while(popOwn(worker, taskIndex) || steal(worker, taskIndex))
+        task(worker, taskIndex);
+}
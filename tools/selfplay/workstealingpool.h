@@ -0,0 +1,40 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+//Runs independent tasks on a fixed number of threads. Every worker starts with a contiguous block
+//of task indices and takes them from the back; a worker that runs out steals from the front of
+//the others, so long tasks don't leave cores idle at the end of a run.
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void(unsigned int worker, std::size_t taskIndex)>;
+
+    explicit WorkStealingPool(unsigned int threadCount);
+
+    unsigned int threadCount() const { return _threadCount; }
+    //Runs the task for every index in [0, taskCount) and returns when all are done
+    void run(std::size_t taskCount, const Task & task);
+
+private:
+    //Each queue sits in its own cache line so workers don't contend on their neighbours
+    struct alignas(64) Queue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> taskIndices;
+    };
+
+    bool popOwn(unsigned int worker, std::size_t & taskIndex);
+    bool steal(unsigned int worker, std::size_t & taskIndex);
+    void work(unsigned int worker, const Task & task);
+
+    unsigned int _threadCount;
+    std::unique_ptr<Queue[]> _queues;
+};
+
+#endif // WORKSTEALINGPOOL_H